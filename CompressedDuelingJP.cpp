@@ -0,0 +1,371 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include "CompressedDuelingJP.h"
+#include "HotPathCounters.h"
+#include "LatencyHistogram.h"
+#include "TraceEvents.h"
+
+
+void CompressedDuelingJP::reserveGroups(int minCapacity) {
+    if (minCapacity <= groupCapacity) {
+        return;
+    }
+
+    int newCapacity = std::max(minCapacity, groupCapacity * 2);
+    JumperGroup *newList = static_cast<JumperGroup *>(
+            ::operator new(sizeof(JumperGroup) * newCapacity));
+
+    std::uninitialized_copy(groupList, groupList + groupCount, newList);
+    ::operator delete(groupList);
+
+    groupList = newList;
+    groupCapacity = newCapacity;
+}
+
+void CompressedDuelingJP::indexGroups() {
+    if (indexCurrent) {
+        return;
+    }
+
+    stateGroups.clear();
+    stateGroups.reserve(groupCount);
+    for (int i = 0; i < groupCount; i++) {
+        stateGroups.emplace(groupList[i].state.getCurrentValue(), i);
+    }
+
+    indexCurrent = true;
+}
+
+int CompressedDuelingJP::addMembers(const JumpPrime &memberState, int count) {
+    int groupNumber = findGroup(memberState);
+
+    if (groupNumber < 0) {
+        reserveGroups(groupCount + 1);
+        groupNumber = groupCount;
+        new(&groupList[groupNumber]) JumperGroup{memberState, 0};
+        stateGroups.emplace(memberState.getCurrentValue(), groupNumber);
+        groupCount++;
+    }
+
+    groupList[groupNumber].multiplicity += count;
+    totalSize += count;
+
+    return groupNumber;
+}
+
+int CompressedDuelingJP::findGroup(const JumpPrime &memberState) {
+    indexGroups();
+
+    // move through the groups with the same number until one has the
+    // same state
+    auto candidates = stateGroups.equal_range(memberState.getCurrentValue());
+    for (auto it = candidates.first; it != candidates.second; ++it) {
+        if (groupList[it->second].state.hasSameState(memberState)) {
+            return it->second;
+        }
+    }
+
+    return -1;
+}
+
+void CompressedDuelingJP::removeGroup(int groupNumber) {
+    indexGroups();
+    groupCount--;
+
+    // drop the removed group's entry and renumber the last group's entry
+    auto candidates = stateGroups.equal_range(
+            groupList[groupNumber].state.getCurrentValue());
+    for (auto it = candidates.first; it != candidates.second; ++it) {
+        if (it->second == groupNumber) {
+            stateGroups.erase(it);
+            break;
+        }
+    }
+
+    if (groupNumber != groupCount) {
+        candidates = stateGroups.equal_range(
+                groupList[groupCount].state.getCurrentValue());
+        for (auto it = candidates.first; it != candidates.second; ++it) {
+            if (it->second == groupCount) {
+                it->second = groupNumber;
+                break;
+            }
+        }
+
+        groupList[groupNumber] = groupList[groupCount];
+    }
+}
+
+bool CompressedDuelingJP::testGroup(int groupNumber) {
+    // every member of a group is in the same state, so reviving the shared
+    // state revives all of them
+    if (!groupList[groupNumber].state.isActive()) {
+        return groupList[groupNumber].state.revive();
+    }
+
+    return true;
+}
+
+
+// assumption: all values in initValues are valid
+CompressedDuelingJP::CompressedDuelingJP(const int *initValues, int size) {
+    groupList = nullptr;
+    groupCount = 0;
+    groupCapacity = 0;
+    totalSize = 0;
+    indexCurrent = false;
+
+    // identical initial values produce identical JumpPrime objects, so
+    // only one JumpPrime (and one prime search) is built per distinct value
+    std::unordered_map<int, int> seedGroups;
+
+    for (int i = 0; i < size; i++) {
+        auto found = seedGroups.find(initValues[i]);
+
+        if (found != seedGroups.end()) {
+            groupList[found->second].multiplicity++;
+            totalSize++;
+        } else {
+            reserveGroups(groupCount + 1);
+            new(&groupList[groupCount]) JumperGroup{JumpPrime(initValues[i]), 1};
+            seedGroups[initValues[i]] = groupCount;
+            groupCount++;
+            totalSize++;
+        }
+    }
+}
+
+CompressedDuelingJP::CompressedDuelingJP(const DuelingJP &sourceObject) {
+    groupList = nullptr;
+    groupCount = 0;
+    groupCapacity = 0;
+    totalSize = 0;
+    indexCurrent = true;
+
+    for (int i = 0; i < sourceObject.listSize; i++) {
+        addMembers(sourceObject.jumperList[i], 1);
+    }
+}
+
+
+CompressedDuelingJP::~CompressedDuelingJP() {
+    ::operator delete(groupList);
+}
+
+
+CompressedDuelingJP::CompressedDuelingJP(
+        const CompressedDuelingJP &sourceObject) {
+    groupList = nullptr;
+    groupCount = 0;
+    groupCapacity = 0;
+    totalSize = sourceObject.totalSize;
+    stateGroups = sourceObject.stateGroups;
+    indexCurrent = sourceObject.indexCurrent;
+
+    reserveGroups(sourceObject.groupCount);
+    std::uninitialized_copy(sourceObject.groupList,
+                            sourceObject.groupList + sourceObject.groupCount,
+                            groupList);
+    groupCount = sourceObject.groupCount;
+}
+
+CompressedDuelingJP::CompressedDuelingJP(CompressedDuelingJP &&sourceObject) {
+    groupList = sourceObject.groupList;
+    groupCount = sourceObject.groupCount;
+    groupCapacity = sourceObject.groupCapacity;
+    totalSize = sourceObject.totalSize;
+    stateGroups = std::move(sourceObject.stateGroups);
+    indexCurrent = sourceObject.indexCurrent;
+
+    // clear the source
+    sourceObject.groupList = nullptr;
+    sourceObject.groupCount = 0;
+    sourceObject.groupCapacity = 0;
+    sourceObject.totalSize = 0;
+    sourceObject.stateGroups.clear();
+    sourceObject.indexCurrent = true;
+}
+
+CompressedDuelingJP &CompressedDuelingJP::operator=(
+        const CompressedDuelingJP &sourceObject) {
+
+    // check to verify they're not the same object
+    if (this != &sourceObject) {
+        CompressedDuelingJP tempObject(sourceObject);
+        *this = std::move(tempObject);
+    }
+
+    return *this;
+}
+
+CompressedDuelingJP &CompressedDuelingJP::operator=(
+        CompressedDuelingJP &&sourceObject) {
+
+    // swap contents
+    std::swap(groupList, sourceObject.groupList);
+    std::swap(groupCount, sourceObject.groupCount);
+    std::swap(groupCapacity, sourceObject.groupCapacity);
+    std::swap(totalSize, sourceObject.totalSize);
+    std::swap(stateGroups, sourceObject.stateGroups);
+    std::swap(indexCurrent, sourceObject.indexCurrent);
+
+    return *this;
+}
+
+CompressedDuelingJP &CompressedDuelingJP::operator+=(
+        const CompressedDuelingJP &addObject) {
+
+    // copy first in case addObject is this object
+    CompressedDuelingJP addCopy(addObject);
+
+    reserveGroups(groupCount + addCopy.groupCount);
+
+    for (int j = 0; j < addCopy.groupCount; j++) {
+        addMembers(addCopy.groupList[j].state,
+                   addCopy.groupList[j].multiplicity);
+    }
+
+    return *this;
+}
+
+long long CompressedDuelingJP::countCollisions(bool testUp,
+                                               TopKTracker *topOutputs) {
+    JP_COUNT(CollisionPasses);
+    JP_LATENCY_SCOPE(CollisionPass);
+    JP_TRACE_SCOPE(CollisionPass, groupCount);
+
+    // the pass changes the states the index is keyed on
+    indexCurrent = false;
+
+    /// For each distinct nonzero output value, the number of members
+    /// returning it
+    std::unordered_map<unsigned int, long long> valueCounts;
+    valueCounts.reserve(groupCount);
+
+    /// true if a member returned 0 after the last new value
+    bool zeroPending = false;
+
+    for (int i = 0; i < groupCount; i++) {
+        unsigned int outputValue;
+        testGroup(i);
+        outputValue = testUp ?
+                groupList[i].state.up() :
+                groupList[i].state.down();
+
+        // as in DuelingJP, 0 results share the counter that the next new
+        // value takes over
+        if (outputValue == 0) {
+            zeroPending = true;
+        } else {
+            long long &valueCount = valueCounts[outputValue];
+            if (valueCount == 0) {
+                zeroPending = false;
+            }
+            valueCount += groupList[i].multiplicity;
+        }
+
+        if (topOutputs != nullptr) {
+            topOutputs->add(outputValue, groupList[i].multiplicity);
+        }
+    }
+
+    // every member after the first to return a value is a collision; the 0
+    // results only have a counter of their own if no new value followed
+    long long zeroCounters = zeroPending ? 1 : 0;
+
+    return static_cast<long long>(totalSize) -
+           static_cast<long long>(valueCounts.size()) - zeroCounters;
+}
+
+long long CompressedDuelingJP::countInversions() {
+    JP_COUNT(InversionPasses);
+    JP_LATENCY_SCOPE(InversionPass);
+    JP_TRACE_SCOPE(InversionPass, groupCount);
+
+    // the pass changes the states the index is keyed on
+    indexCurrent = false;
+
+    /// For each output value, the number of members returning it from
+    /// up() and from down()
+    struct InversionCounter {
+        long long upCount = 0;
+        long long downCount = 0;
+    };
+
+    std::unordered_map<unsigned int, InversionCounter> valueCounts;
+    valueCounts.reserve(2 * groupCount);
+
+    for (int i = 0; i < groupCount; i++) {
+        // In case the group was inactive
+        testGroup(i);
+        valueCounts[groupList[i].state.up()].upCount +=
+                groupList[i].multiplicity;
+
+        // In case the up jump deactivated it
+        testGroup(i);
+        valueCounts[groupList[i].state.down()].downCount +=
+                groupList[i].multiplicity;
+    }
+
+    long long inversionCounter = 0;
+
+    for (const auto &entry : valueCounts) {
+        inversionCounter += entry.second.upCount * entry.second.downCount;
+    }
+
+    return inversionCounter;
+}
+
+bool CompressedDuelingJP::reviveMember(int groupNumber) {
+    JumpPrime memberState = groupList[groupNumber].state;
+    bool returnValue = memberState.revive();
+
+    // split the member from its group
+    groupList[groupNumber].multiplicity--;
+    totalSize--;
+    if (groupList[groupNumber].multiplicity == 0) {
+        removeGroup(groupNumber);
+    }
+
+    addMembers(memberState, 1);
+
+    return returnValue;
+}
+
+bool CompressedDuelingJP::resetMember(int groupNumber) {
+    JumpPrime memberState = groupList[groupNumber].state;
+    bool returnValue = memberState.reset();
+
+    // split the member from its group
+    groupList[groupNumber].multiplicity--;
+    totalSize--;
+    if (groupList[groupNumber].multiplicity == 0) {
+        removeGroup(groupNumber);
+    }
+
+    addMembers(memberState, 1);
+
+    return returnValue;
+}
+
+int CompressedDuelingJP::getSize() const {
+    return totalSize;
+}
+
+int CompressedDuelingJP::getGroupCount() const {
+    return groupCount;
+}
+
+int CompressedDuelingJP::getMultiplicity(int groupNumber) const {
+    return groupList[groupNumber].multiplicity;
+}
+
+unsigned int CompressedDuelingJP::getGroupValue(int groupNumber) const {
+    return groupList[groupNumber].state.getCurrentValue();
+}
@@ -0,0 +1,226 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_COMPRESSEDDUELINGJP_H
+#define INC_5011_P4_COMPRESSEDDUELINGJP_H
+
+#include <unordered_map>
+#include "JumpPrime.h"
+#include "DuelingJP.h"
+
+
+/*
+ * The CompressedDuelingJP is a DuelingJP for populations with many
+ * duplicate JumpPrime objects. Instead of storing every JumpPrime object, it
+ * stores each distinct JumpPrime state once (a "group") along with the
+ * number of members that currently share that state (its multiplicity).
+ * Members of a group return identical results from every call, so a query
+ * is made once per group and weighted by the multiplicity. Memory and the
+ * cost of a counting pass scale with the number of distinct states rather
+ * than the total population.
+ *
+ * METHODS:
+ * 1. The constructor accepts either an array of initial values (identical
+ * values share a group) or an existing DuelingJP object (identical states
+ * share a group).
+ * 2. countCollisions and countInversions count exactly what the same
+ * methods of DuelingJP count for the expanded population, listed group by
+ * group in group order. DuelingJP merges a run of 0 outputs (from failed
+ * JumpPrime objects) into the next new value, so countCollisions does the
+ * same; as that depends on the order of the members, the count may differ
+ * by one from that of a DuelingJP object listing the members in another
+ * order, such as the one this object was compressed from.
+ * 3. reviveMember and resetMember operate on a single member of a group.
+ * The member is split from its group first (unless it is the only member)
+ * and rejoins any group that already has its new state.
+ * 4. += merges the groups of another CompressedDuelingJP object.
+ *
+ * ASSUMPTIONS:
+ * 1. Members are identified by the group they are in; the members of a
+ * group are interchangeable. Group numbers are stable across counting
+ * passes, but reviveMember and resetMember may renumber groups (a split
+ * member may start a new group at the end, and an emptied group is
+ * replaced by the last group).
+ * 2. Collisions between members of the same group follow from the
+ * multiplicity: a group of m members produces m - 1 collisions on its own.
+ * 3. As with DuelingJP, inactive groups are revived before each query.
+ * 4. Counts are returned as long long because they are weighted by the
+ * multiplicities and may exceed the range of int for large populations.
+ * 5. Groups are found by a hash index on their encapsulated number, so
+ * adding or splitting a member costs O(1) on average. A counting pass
+ * changes the states, so the index is rebuilt (O(groups)) by the first
+ * split or addition after a pass rather than during the pass.
+ */
+
+/// CompressedDuelingJP is a DuelingJP that stores distinct JumpPrime states
+/// together with their multiplicity.
+class CompressedDuelingJP {
+
+    /// JumperGroup is one distinct JumpPrime state and its members.
+    struct JumperGroup {
+        /// The state shared by every member of the group.
+        JumpPrime state;
+
+        /// The number of members in the group.
+        int multiplicity;
+    };
+
+    /// Pointer to array of JumperGroup objects of size groupCount.
+    JumperGroup *groupList;
+
+    /// The number of groups in groupList.
+    int groupCount;
+
+    /// The number of groups groupList has room for.
+    int groupCapacity;
+
+    /// The total number of members across all groups.
+    int totalSize;
+
+    /// GroupIndex finds groups by encapsulated number. Groups with the same
+    /// number but different states share a key.
+    typedef std::unordered_multimap<unsigned int, int> GroupIndex;
+
+    /// The group number of every group, keyed by its encapsulated number.
+    /// Only valid while indexCurrent is true.
+    GroupIndex stateGroups;
+
+    /// false once a counting pass has changed the group states since
+    /// stateGroups was built.
+    bool indexCurrent;
+
+    /// indexGroups rebuilds stateGroups if a counting pass has made it
+    /// stale.
+    void indexGroups();
+
+    /// reserveGroups makes room for at least a given number of groups.
+    /// @param [in] minCapacity The number of groups to make room for.
+    void reserveGroups(int minCapacity);
+
+    /// addMembers adds members with a given state, joining an existing
+    /// group with the same state if there is one.
+    /// @param [in] memberState The state of the new members.
+    /// @param [in] count The number of members to add.
+    /// @return The group number the members were added to.
+    int addMembers(const JumpPrime &memberState, int count);
+
+    /// findGroup finds the group with a given state.
+    /// @param [in] memberState The state to look for.
+    /// @return The group number, or -1 if no group has that state.
+    int findGroup(const JumpPrime &memberState);
+
+    /// removeGroup removes an empty group, moving the last group into its
+    /// place.
+    /// @param [in] groupNumber The group to remove.
+    void removeGroup(int groupNumber);
+
+    /// testGroup verifies that a group is active and ready for testing.
+    /// If not, it revives all of its members.
+    /// @param [in] groupNumber The group to test.
+    /// @return true if the group is active and ready for use.
+    bool testGroup(int groupNumber);
+
+public:
+
+    /// CompressedDuelingJP Constructor creates a new CompressedDuelingJP
+    /// object with a JumpPrime object for every initial value. Identical
+    /// initial values share a group.
+    /// @param [in] initValues Array of initial values for JumpPrime objects
+    /// @param [in] size The size of the array of initial values.
+    /// @pre All values of array are valid JumpPrime initial values.
+    CompressedDuelingJP(const int *initValues, int size);
+
+    /// CompressedDuelingJP Constructor compresses the JumpPrime objects of
+    /// a DuelingJP object. JumpPrime objects with identical state share a
+    /// group.
+    /// @param [in] sourceObject The DuelingJP object to compress.
+    explicit CompressedDuelingJP(const DuelingJP &sourceObject);
+
+    /// CompressedDuelingJP Destructor for disposing of JumperGroup garbage
+    ~CompressedDuelingJP();
+
+    /// CompressedDuelingJP Copy Constructor creates a duplicate object with
+    /// the same groups.
+    /// @param [in] sourceObject The CompressedDuelingJP object to copy.
+    CompressedDuelingJP(const CompressedDuelingJP &sourceObject);
+
+    /// CompressedDuelingJP Move Constructor takes the groups of the source
+    /// and leaves it empty.
+    /// @param [in] sourceObject The CompressedDuelingJP object to move.
+    CompressedDuelingJP(CompressedDuelingJP &&sourceObject);
+
+    /// Assigns a duplicate of the groups of another CompressedDuelingJP.
+    /// @param [in] sourceObject The CompressedDuelingJP object to copy.
+    /// @return A reference to this object.
+    CompressedDuelingJP &operator=(const CompressedDuelingJP &sourceObject);
+
+    /// Swaps the groups of another CompressedDuelingJP into this one.
+    /// @param [in] sourceObject The CompressedDuelingJP object to move.
+    /// @return A reference to this object.
+    CompressedDuelingJP &operator=(CompressedDuelingJP &&sourceObject);
+
+    /**
+     * Adds the members of another CompressedDuelingJP object to this one.
+     * Members whose state matches an existing group join that group.
+     * @param addObject the CompressedDuelingJP object to add
+     * @return a reference to this object
+     */
+    CompressedDuelingJP &operator+=(const CompressedDuelingJP &addObject);
+
+    /// countCollisions makes a single pass through the groups, querying
+    /// each group once and counting every member that returns a value
+    /// already returned by another member.
+    /// @param [in] testUp If true, tests the JumpPrime objects in the "up"
+    /// direction. Defaults to true.
+    /// @param [in,out] topOutputs If not nullptr, every group's result is
+    /// also added to this tracker, weighted by its multiplicity.
+    /// @return The number of members that collided.
+    long long countCollisions(bool testUp = true,
+                              TopKTracker *topOutputs = nullptr);
+
+    /// countInversions queries both the up() and down() methods of every
+    /// group and counts the number of (member, member) pairs where an up()
+    /// result equals a down() result.
+    /// @return The number of inversions across all members.
+    long long countInversions();
+
+    /// reviveMember revives a single member of a group, splitting it from
+    /// the rest of its group.
+    /// @param [in] groupNumber The group the member belongs to.
+    /// @return The result of reviving the member (see JumpPrime::revive).
+    /// @pre 0 <= groupNumber < getGroupCount()
+    bool reviveMember(int groupNumber);
+
+    /// resetMember resets a single member of a group, splitting it from
+    /// the rest of its group.
+    /// @param [in] groupNumber The group the member belongs to.
+    /// @return The result of resetting the member (see JumpPrime::reset).
+    /// @pre 0 <= groupNumber < getGroupCount()
+    bool resetMember(int groupNumber);
+
+    /// getSize returns the total number of members.
+    /// @return The number of JumpPrime objects represented.
+    int getSize() const;
+
+    /// getGroupCount returns the number of distinct states stored.
+    /// @return The number of groups.
+    int getGroupCount() const;
+
+    /// getMultiplicity returns the number of members in a group.
+    /// @param [in] groupNumber The group to query.
+    /// @return The number of members in the group.
+    /// @pre 0 <= groupNumber < getGroupCount()
+    int getMultiplicity(int groupNumber) const;
+
+    /// getGroupValue returns the number currently encapsulated by the
+    /// members of a group.
+    /// @param [in] groupNumber The group to query.
+    /// @return The encapsulated number of the group.
+    /// @pre 0 <= groupNumber < getGroupCount()
+    unsigned int getGroupValue(int groupNumber) const;
+
+};
+
+
+#endif //INC_5011_P4_COMPRESSEDDUELINGJP_H
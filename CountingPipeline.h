@@ -0,0 +1,389 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_COUNTINGPIPELINE_H
+#define INC_5011_P4_COUNTINGPIPELINE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "SpscRing.h"
+
+
+/*
+ * CountingPipeline splits a counting pass into two stages on separate
+ * threads: generator threads produce outputs (the up() and down() calls,
+ * with their occasional expensive jumps) and aggregator threads count
+ * them. The slow generation then overlaps with the counting instead of
+ * alternating with it on one thread.
+ *
+ * Each generator emits (value, direction) pairs. A pair goes to the
+ * aggregator that owns its value (chosen by a hash of the value), so every
+ * aggregator counts a disjoint set of values in its own hash table and no
+ * table is shared. Pairs travel in batches through one SpscRing per
+ * (generator, aggregator) pair, so every ring has a single producer and a
+ * single consumer. When an aggregator falls behind, its rings fill and the
+ * generators feeding it wait: memory in flight is bounded by
+ * generators * aggregators * RING_BATCHES batches.
+ *
+ * At the end every aggregator reports, for the values it owns, how many
+ * up and down outputs there were, how many distinct values of each, and
+ * the number of (up, down) pairs of equal values; PipelineCounts adds
+ * these up. The collision count of a direction is its outputs minus its
+ * distinct values, and the inversion count is the number of equal pairs.
+ *
+ * ASSUMPTIONS:
+ * 1. The generate function is called once on each generator thread with
+ * the generator's number, the number of generators and an Emitter for
+ * that thread; it must emit every output that generator is responsible
+ * for. The calling thread of run is generator 0.
+ * 2. A generator's outputs arrive at their aggregators in the order it
+ * emitted them, but the counts do not depend on the order.
+ */
+
+/// PipelineCounts is what the aggregators of a pipeline counted.
+struct PipelineCounts {
+    long long upOutputs = 0;
+    long long downOutputs = 0;
+
+    /// The number of distinct values among the up and down outputs.
+    long long distinctUp = 0;
+    long long distinctDown = 0;
+
+    /// The number of (up, down) output pairs with equal values.
+    long long inversionPairs = 0;
+};
+
+/// CountingPipeline counts the outputs of generator threads on aggregator
+/// threads.
+template <class Value>
+class CountingPipeline {
+
+public:
+
+    /// The number of outputs sent to an aggregator at a time.
+    static constexpr int BATCH_SIZE = 512;
+
+    /// The number of batches each ring holds.
+    static constexpr int RING_BATCHES = 8;
+
+private:
+
+    /// Batch is a run of outputs for one aggregator.
+    struct Batch {
+        int count = 0;
+        Value values[BATCH_SIZE];
+        bool isDown[BATCH_SIZE];
+    };
+
+    /// The rings, generator-major: ring (g, a) is rings[g * aggregatorCount + a].
+    SpscRing<Batch> **rings;
+
+    int generatorCount;
+    int aggregatorCount;
+
+    /// mixValue spreads a value over 64 bits (the splitmix64 finalizer);
+    /// the high half picks the aggregator and the low bits a table slot.
+    static std::uint64_t mixValue(std::uint64_t value) {
+        value += 0x9e3779b97f4a7c15ull;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+
+    /// ValueTable counts the up and down outputs of each value an
+    /// aggregator owns, in an open-addressing hash table that doubles
+    /// when half full.
+    class ValueTable {
+
+        Value *keys;
+        int *upCounts;
+        int *downCounts;
+        std::uint64_t slotMask;
+        std::uint64_t usedSlots;
+
+        /// findSlot returns the slot holding value, or the empty slot
+        /// where it belongs.
+        std::uint64_t findSlot(Value value) const {
+            std::uint64_t slot = mixValue(value) & slotMask;
+            while (((upCounts[slot] != 0) || (downCounts[slot] != 0)) &&
+                   (keys[slot] != value)) {
+                slot = (slot + 1) & slotMask;
+            }
+            return slot;
+        }
+
+        /// allocate makes an empty table of a number of slots.
+        void allocate(std::uint64_t slots) {
+            keys = new Value[slots];
+            upCounts = new int[slots]();
+            downCounts = new int[slots]();
+            slotMask = slots - 1;
+            usedSlots = 0;
+        }
+
+        /// grow doubles the table, moving every value.
+        void grow() {
+            Value *oldKeys = keys;
+            int *oldUpCounts = upCounts;
+            int *oldDownCounts = downCounts;
+            std::uint64_t oldSlots = slotMask + 1;
+
+            allocate(2 * oldSlots);
+            for (std::uint64_t i = 0; i < oldSlots; i++) {
+                if ((oldUpCounts[i] != 0) || (oldDownCounts[i] != 0)) {
+                    std::uint64_t slot = findSlot(oldKeys[i]);
+                    keys[slot] = oldKeys[i];
+                    upCounts[slot] = oldUpCounts[i];
+                    downCounts[slot] = oldDownCounts[i];
+                    usedSlots++;
+                }
+            }
+
+            delete[] oldKeys;
+            delete[] oldUpCounts;
+            delete[] oldDownCounts;
+        }
+
+    public:
+
+        ValueTable() {
+            allocate(1024);
+        }
+
+        ~ValueTable() {
+            delete[] keys;
+            delete[] upCounts;
+            delete[] downCounts;
+        }
+
+        ValueTable(const ValueTable &) = delete;
+        ValueTable &operator=(const ValueTable &) = delete;
+
+        /// add counts one output.
+        void add(Value value, bool isDown) {
+            std::uint64_t slot = findSlot(value);
+            if ((upCounts[slot] == 0) && (downCounts[slot] == 0)) {
+                if (2 * (usedSlots + 1) > slotMask + 1) {
+                    grow();
+                    slot = findSlot(value);
+                }
+                keys[slot] = value;
+                usedSlots++;
+            }
+            if (isDown) {
+                downCounts[slot]++;
+            } else {
+                upCounts[slot]++;
+            }
+        }
+
+        /// addCounts adds the table's totals to counts.
+        void addCounts(PipelineCounts &counts) const {
+            for (std::uint64_t i = 0; i <= slotMask; i++) {
+                counts.upOutputs += upCounts[i];
+                counts.downOutputs += downCounts[i];
+                counts.distinctUp += (upCounts[i] != 0);
+                counts.distinctDown += (downCounts[i] != 0);
+                counts.inversionPairs += static_cast<long long>(upCounts[i]) *
+                                         downCounts[i];
+            }
+        }
+
+    };
+
+    /// ring returns the ring from a generator to an aggregator.
+    SpscRing<Batch> &ring(int generatorNumber, int aggregatorNumber) {
+        return *rings[generatorNumber * aggregatorCount + aggregatorNumber];
+    }
+
+    /// aggregatorOf returns the aggregator that owns a value.
+    int aggregatorOf(Value value) const {
+        return static_cast<int>((mixValue(value) >> 32) %
+                                static_cast<std::uint64_t>(aggregatorCount));
+    }
+
+    /// runAggregator counts the batches sent to one aggregator until every
+    /// generator has finished.
+    /// @param [in] aggregatorNumber The aggregator.
+    /// @param [out] counts The aggregator's totals.
+    void runAggregator(int aggregatorNumber, PipelineCounts &counts) {
+        ValueTable table;
+        std::vector<bool> drained(generatorCount, false);
+        int openRings = generatorCount;
+
+        while (openRings > 0) {
+            bool progress = false;
+            for (int g = 0; g < generatorCount; g++) {
+                if (drained[g]) {
+                    continue;
+                }
+
+                SpscRing<Batch> &input = ring(g, aggregatorNumber);
+                Batch *batch = input.frontSlot();
+                if (batch != nullptr) {
+                    for (int i = 0; i < batch->count; i++) {
+                        table.add(batch->values[i], batch->isDown[i]);
+                    }
+                    input.release();
+                    progress = true;
+                } else if (input.isDrained()) {
+                    drained[g] = true;
+                    openRings--;
+                }
+            }
+
+            if (!progress) {
+                std::this_thread::yield();
+            }
+        }
+
+        table.addCounts(counts);
+    }
+
+public:
+
+    /// Emitter sends one generator's outputs to the aggregators.
+    class Emitter {
+
+        CountingPipeline *pipeline;
+        int generatorNumber;
+
+        /// The batch being filled for each aggregator, or nullptr.
+        std::vector<Batch *> openBatches;
+
+        /// claimBatch waits for a free batch in the ring to an aggregator.
+        Batch *claimBatch(int aggregatorNumber) {
+            SpscRing<Batch> &output = pipeline->ring(generatorNumber, aggregatorNumber);
+            Batch *batch;
+            while ((batch = output.claimSlot()) == nullptr) {
+                // backpressure: the aggregator has not caught up yet
+                std::this_thread::yield();
+            }
+            batch->count = 0;
+            return batch;
+        }
+
+    public:
+
+        Emitter(CountingPipeline &ownerPipeline, int ownerGenerator)
+                : openBatches(ownerPipeline.aggregatorCount, nullptr) {
+            pipeline = &ownerPipeline;
+            generatorNumber = ownerGenerator;
+        }
+
+        Emitter(const Emitter &) = delete;
+        Emitter &operator=(const Emitter &) = delete;
+
+        /// emit sends one output to the aggregator that owns its value.
+        /// @param [in] value The output.
+        /// @param [in] isDown true for a down() output, false for up().
+        void emit(Value value, bool isDown) {
+            int aggregatorNumber = pipeline->aggregatorOf(value);
+            Batch *&batch = openBatches[aggregatorNumber];
+            if (batch == nullptr) {
+                batch = claimBatch(aggregatorNumber);
+            }
+
+            batch->values[batch->count] = value;
+            batch->isDown[batch->count] = isDown;
+            batch->count++;
+
+            if (batch->count == BATCH_SIZE) {
+                pipeline->ring(generatorNumber, aggregatorNumber).publish();
+                batch = nullptr;
+            }
+        }
+
+        /// finish sends the partly filled batches and closes the rings.
+        void finish() {
+            for (int a = 0; a < pipeline->aggregatorCount; a++) {
+                SpscRing<Batch> &output = pipeline->ring(generatorNumber, a);
+                if (openBatches[a] != nullptr) {
+                    output.publish();
+                    openBatches[a] = nullptr;
+                }
+                output.close();
+            }
+        }
+
+    };
+
+    /// CountingPipeline Constructor sets up the rings between the stages.
+    /// @param [in] generators The generator threads; 0 for half the cores.
+    /// @param [in] aggregators The aggregator threads; 0 for the rest of
+    /// the cores.
+    CountingPipeline(int generators, int aggregators) {
+        int cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        generatorCount = (generators > 0) ? generators : std::max(1, cores / 2);
+        aggregatorCount = (aggregators > 0) ? aggregators :
+                          std::max(1, cores - generatorCount);
+
+        rings = new SpscRing<Batch> *[generatorCount * aggregatorCount];
+        for (int r = 0; r < generatorCount * aggregatorCount; r++) {
+            rings[r] = new SpscRing<Batch>(RING_BATCHES);
+        }
+    }
+
+    /// CountingPipeline Destructor frees the rings.
+    ~CountingPipeline() {
+        for (int r = 0; r < generatorCount * aggregatorCount; r++) {
+            delete rings[r];
+        }
+        delete[] rings;
+    }
+
+    CountingPipeline(const CountingPipeline &) = delete;
+    CountingPipeline &operator=(const CountingPipeline &) = delete;
+
+    /// getGeneratorCount returns the number of generator threads.
+    int getGeneratorCount() const {
+        return generatorCount;
+    }
+
+    /// run runs both stages to completion. A pipeline runs once.
+    /// @param [in] generate Called as generate(generatorNumber,
+    /// generatorCount, emitter) on every generator thread.
+    /// @return The totals of every aggregator.
+    template <class Generate>
+    PipelineCounts run(Generate generate) {
+        std::vector<PipelineCounts> aggregatorCounts(aggregatorCount);
+        std::vector<std::thread> threads;
+
+        for (int a = 0; a < aggregatorCount; a++) {
+            threads.emplace_back(&CountingPipeline::runAggregator, this, a,
+                                 std::ref(aggregatorCounts[a]));
+        }
+
+        auto runGenerator = [this, &generate](int generatorNumber) {
+            Emitter emitter(*this, generatorNumber);
+            generate(generatorNumber, generatorCount, emitter);
+            emitter.finish();
+        };
+        for (int g = 1; g < generatorCount; g++) {
+            threads.emplace_back(runGenerator, g);
+        }
+        runGenerator(0);
+
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+
+        PipelineCounts counts;
+        for (const PipelineCounts &partial : aggregatorCounts) {
+            counts.upOutputs += partial.upOutputs;
+            counts.downOutputs += partial.downOutputs;
+            counts.distinctUp += partial.distinctUp;
+            counts.distinctDown += partial.distinctDown;
+            counts.inversionPairs += partial.inversionPairs;
+        }
+        return counts;
+    }
+
+};
+
+
+#endif //INC_5011_P4_COUNTINGPIPELINE_H
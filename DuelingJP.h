@@ -5,7 +5,19 @@
 #ifndef INC_5011_P2_DUELINGJP_H
 #define INC_5011_P2_DUELINGJP_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "HyperLogLog.h"
+#include "CountingPipeline.h"
 #include "JumpPrime.h"
+#include "SortedValueIndex.h"
+#include "TopKTracker.h"
+
+// expression template types for DuelingJP addition (DuelingJPExpr.h)
+template <class Traits> class DuelingJPTerm;
+template <class Traits> class JumpPrimeTerm;
+template <class LeftExpr, class RightExpr> class DuelingJPSum;
 
 
 /*
@@ -51,27 +63,204 @@
  * 6. A JumpPrime object can be added to a DuelingJP object. This increases
  * the size of the DuelingJP by one, adding a new JumpPrime object at the end
  * of the DuelingJP object.
+ * 7. Addition is lazy. Adding DuelingJP and JumpPrime objects yields a
+ * DuelingJPSum expression that records the operands; a chain such as
+ * djp1 + djp2 + jp + djp3 builds the resulting DuelingJP exactly once (one
+ * allocation, one prime search per JumpPrime) when the expression is
+ * assigned to or used to construct a DuelingJP. The expression can also be
+ * used directly as the DuelingJP it stands for (e.g., (djp1 + djp2) == djp3
+ * or (djp1 + djp2).countCollisions()), which evaluates it once; see
+ * DuelingJPExpr.h. It shares its DuelingJP operands' arrays, so it stays
+ * valid when held in a variable (`auto sum = djp1 + djp2;`).
+ * 8. Copies of a DuelingJP object share the same array of JumpPrime objects
+ * (copy-on-write). Copying is O(1); the first mutating call on a copy
+ * (countCollisions, countInversions, +=) detaches it onto its own array.
+ * Separate DuelingJP objects that share an array may be read and copied
+ * from different threads at the same time; a single DuelingJP object is
+ * not safe to mutate from more than one thread at a time.
+ * 9. BasicDuelingJP holds BasicJumpPrime objects of the same traits class
+ * (see JumpPrime.h); DuelingJP is the default configuration. Only DuelingJP
+ * objects can be compressed, streamed, sharded or snapshotted.
+ * 10. countCollisionsApprox estimates the collision count as the population
+ * size minus a HyperLogLog estimate of the distinct outputs (see
+ * HyperLogLog.h). Its sketch uses 2^precision bytes whatever the population
+ * size (16 KB at the default precision 14). The result is exact while there
+ * are at most 2^precision / 16 distinct outputs (1024 at the default).
+ * Beyond that the distinct count, not the collision count, is within about
+ * 0.8% at the default precision. That error is subtracted from the
+ * population size, so when collisions are few compared with the distinct
+ * outputs the relative error of the collision count is far larger (e.g.,
+ * 142 exact collisions among 5000 seeds may be estimated as 84).
+ * sketchOutputs fills a caller's sketch instead,
+ * so sketches of several DuelingJP objects (one per thread or shard) can be
+ * merged and the collisions of the combined population estimated.
+ * 11. countCollisions, countCollisionsApprox and sketchOutputs optionally
+ * feed every output to a TopKTracker (see TopKTracker.h) during the same
+ * pass, reporting which values collected the most JumpPrime objects.
+ * 12. countInRange and nearestJumper answer in O(log n) from a sorted index
+ * of the encapsulated numbers (see SortedValueIndex.h). The index is built
+ * on the first such query and kept with the JumpPrime array, so copies
+ * sharing the array share it. Once built, it is kept up to date: every
+ * call that may jump a JumpPrime object (a counting pass, resetAll)
+ * updates it at the end, re-sorting only the objects whose number moved,
+ * so queries between passes stay O(log n). A copy that detaches onto its
+ * own array builds its own index on its next query. Queries on one
+ * DuelingJP object must not run concurrently with a counting pass on that
+ * object.
+ * 13. countCollisionsPipelined and countInversionsPipelined return the same
+ * counts as countCollisions and countInversions (for outputs other than 0,
+ * which valid JumpPrime objects do not produce), but query the JumpPrime
+ * objects on generator threads and count the outputs on aggregator threads
+ * (see CountingPipeline.h), so slow queries overlap with counting. Each
+ * JumpPrime object is queried on one generator thread, in the same order
+ * of up() and down() calls as the single-threaded pass. The inversion
+ * count is found in O(n) rather than O(n^2).
+ * 14. The store keeps an activity bitmap with one bit per JumpPrime object,
+ * set while the object is active. Counting passes read it 64 objects at a
+ * time: when every object of a word is active, the word is queried without
+ * the per-object isActive()/revive() check, and the word is rewritten
+ * from the objects' states after the queries. (countInversions still
+ * checks each object between its up() and down() calls, since the up()
+ * may deactivate it.) resetAll, reviveAll and activeCount work on the
+ * whole population a word at a time.
  */
 
-/// DuelingJP is a container for JumpPrime objects used for testing.
-class DuelingJP {
+/// BasicDuelingJP is a container for JumpPrime objects used for testing.
+template <class Traits>
+class BasicDuelingJP {
+
+    /// The JumpPrime configuration held by this container.
+    typedef BasicJumpPrime<Traits> Jumper;
+
+public:
+
+    /// The type of the encapsulated numbers and of the query results.
+    typedef typename Jumper::Value Value;
+
+private:
+
+    /// DuelingJPTerm reads jumperList when building an addition result.
+    template <class TermTraits> friend class DuelingJPTerm;
+
+    /// CompressedDuelingJP reads jumperList when compressing a DuelingJP.
+    friend class CompressedDuelingJP;
+
+    /// ShardedDuelingJP copies jumperList into its shared segment.
+    friend class ShardedDuelingJP;
+
+    /// DuelingJPSnapshot saves jumperList and loads it back in place.
+    friend class DuelingJPSnapshot;
+
+    /// JumperStore is the reference-counted array of JumpPrime objects
+    /// shared by copies of a DuelingJP object.
+    struct JumperStore {
+        /// The number of DuelingJP objects sharing this store.
+        std::atomic<int> refCount;
+
+        /// Uninitialized storage for the JumpPrime objects.
+        Jumper *jumpers;
+
+        /// Start of the memory mapping holding jumpers, or nullptr if the
+        /// jumpers were allocated with operator new.
+        void *mappedBase;
+
+        /// The length of the memory mapping at mappedBase.
+        std::size_t mappedLength;
+
+        /// Sorted index of the jumpers' numbers, or nullptr until a query
+        /// needs it.
+        std::atomic<SortedValueIndex<Value> *> valueIndex;
+
+        /// The activity bitmap: bit k of word w is set while jumper
+        /// 64 * w + k is active (see allocateActivity).
+        std::uint64_t *activeBits;
+    };
+
+    /// The number of jumpers covered by one word of the activity bitmap.
+    static constexpr int ACTIVITY_WORD_BITS = 64;
+
+    /// The shared store that owns jumperList. nullptr after a move.
+    JumperStore *jumperStore;
 
     /// Pointer to array of JumpPrime objects of size listSize.
-    JumpPrime *jumperList;
+    Jumper *jumperList;
 
     /// The size of the jumperList array.
     int listSize;
 
-    /// areActive verifies that all JumpPrime objects are currently active
-    /// (i.e., they have not been deactivated).
-    /// @return true if all of the member JumpPrime objects are active.
-    /// @deprecated
-    bool areActive();
-
-    /// reactivateJumpers goes through all of the JumpPrime objects and
-    /// reactivates any that were not active.
-    /// @deprecated
-    void reactivateJumpers();
+    /// allocateStore creates a store with room for a given number of
+    /// JumpPrime objects and a reference count of one. The JumpPrime
+    /// objects are not constructed; the caller must construct every one
+    /// and then call rebuildActivity.
+    /// @param [in] size The number of JumpPrime objects to make room for.
+    /// @return The new store.
+    static JumperStore *allocateStore(int size);
+
+    /// activityWords returns the number of bitmap words for a population.
+    /// @param [in] size The number of JumpPrime objects.
+    /// @return The number of words.
+    static int activityWords(int size);
+
+    /// allocateActivity allocates a cleared activity bitmap.
+    /// @param [in] size The number of JumpPrime objects it covers.
+    /// @return The bitmap; free it with delete[].
+    static std::uint64_t *allocateActivity(int size);
+
+    /// rebuildActivity sets every word of the activity bitmap from the
+    /// states of the JumpPrime objects.
+    void rebuildActivity();
+
+    /// queryWords queries every JumpPrime object covered by a range of
+    /// bitmap words once in one direction, reviving inactive ones first
+    /// unless the bitmap shows the whole word active, and keeps those
+    /// words current.
+    /// @param [in] firstWord The first word of the range.
+    /// @param [in] lastWord One past the last word of the range.
+    /// @param [in] testUp If true, calls up(), otherwise down().
+    /// @param [in] visit Called as visit(jumperNumber, result) in order.
+    template <class Visitor>
+    void queryWords(int firstWord, int lastWord, bool testUp, Visitor visit);
+
+    /// queryInversionWords makes the up() then down() calls of an
+    /// inversion pass on every JumpPrime object covered by a range of
+    /// bitmap words, and keeps those words current.
+    /// @param [in] firstWord The first word of the range.
+    /// @param [in] lastWord One past the last word of the range.
+    /// @param [in] visit Called as visit(jumperNumber, upResult,
+    /// downResult) in order.
+    template <class Visitor>
+    void queryInversionWords(int firstWord, int lastWord, Visitor visit);
+
+    /// DuelingJP Store Constructor creates a DuelingJP object that uses an
+    /// already populated store.
+    /// @param [in] newStore The store to use. Its reference is taken over.
+    /// @param [in] size The number of JumpPrime objects in newStore.
+    BasicDuelingJP(JumperStore *newStore, int size);
+
+    /// adoptStore makes this DuelingJP the user of a freshly allocated
+    /// store, releasing whatever store it used before.
+    /// @param [in] newStore The store to adopt. Its reference is taken over.
+    /// @param [in] size The number of JumpPrime objects in newStore.
+    void adoptStore(JumperStore *newStore, int size);
+
+    /// releaseStore drops this object's reference to its store and frees
+    /// the store if this was the last reference.
+    void releaseStore();
+
+    /// detach gives this DuelingJP its own copy of the JumpPrime array if
+    /// the array is currently shared with other DuelingJP objects. Must be
+    /// called before any JumpPrime object in jumperList is modified, and
+    /// followed by updateIndex once they have been.
+    void detach();
+
+    /// sortedIndex returns the index of the encapsulated numbers, building
+    /// it first if it has not been built for this JumpPrime array.
+    /// @return The index; nullptr if this object has no JumpPrime objects.
+    const SortedValueIndex<Value> *sortedIndex() const;
+
+    /// updateIndex brings the index, if one has been built, up to date
+    /// after JumpPrime objects may have jumped.
+    void updateIndex();
 
     /// testJumper verifies that a specified JumpPrime object is active and
     /// ready for testing. If not, it revives the object.
@@ -80,41 +269,82 @@ class DuelingJP {
     /// active and ready for use
     bool testJumper(int jumperNumber);
 
+    /// fillInversionOutputs makes the up() then down() pass shared by
+    /// countInversions and queryInversionOutputs.
+    /// @param [out] upOutputs Array of listSize up() results.
+    /// @param [out] downOutputs Array of listSize down() results.
+    void fillInversionOutputs(Value *upOutputs, Value *downOutputs);
+
 public:
 
     /// DuelingJP Constructor creates a new DuelingJP object with a set of
     /// JumpPrime objects specified by a given array of initial values.
     /// @param [in] initValues Array of initial values for JumpPrime objects
     /// @param [in] size The size of the array of initial values.
+    /// @param [in] jumpBound The jump bound of every JumpPrime object.
+    /// @param [in] jumpSize The jump value of every JumpPrime object.
+    /// @pre All values of array are valid JumpPrime initial values.
+    BasicDuelingJP(const int *initValues, int size,
+                   unsigned int jumpBound = Traits::JUMP_BOUND,
+                   int jumpSize = Traits::JUMP_VALUE);
+
+    /// DuelingJP Value Constructor creates a new DuelingJP object from
+    /// initial values of the configuration's number type, for seeds beyond
+    /// the range of int.
+    /// @param [in] initValues Array of initial values for JumpPrime objects
+    /// @param [in] size The size of the array of initial values.
+    /// @param [in] jumpBound The jump bound of every JumpPrime object.
+    /// @param [in] jumpSize The jump value of every JumpPrime object.
     /// @pre All values of array are valid JumpPrime initial values.
-    DuelingJP(const int *initValues, int size);
+    BasicDuelingJP(const Value *initValues, int size,
+                   unsigned int jumpBound = Traits::JUMP_BOUND,
+                   int jumpSize = Traits::JUMP_VALUE);
 
     /// DuelingJP Destructor for disposing of JumpPrime garbage
-    ~DuelingJP();
+    ~BasicDuelingJP();
 
     /// DuelingJP Copy Constructor creates a duplicate DuelingJP object with
     /// the same JumpPrime objects.
+    /// The JumpPrime objects are shared with the source until either
+    /// object is modified.
     /// @param [in] sourceObject The DuelingJP object to copy.
-    DuelingJP(DuelingJP &sourceObject);
+    BasicDuelingJP(const BasicDuelingJP &sourceObject);
 
 
     /// DuelingJP Move Constructor assigns a new DuelingJP with the content
     /// of the original and eliminates the source.
     /// @param [in] sourceObject The DuelingJP object to move
-    DuelingJP(DuelingJP && sourceObject);
+    BasicDuelingJP(BasicDuelingJP && sourceObject);
+
+    /// DuelingJP Expression Constructor builds a DuelingJP object from an
+    /// addition expression in a single allocation. Together with the
+    /// expression assignment operator this makes `DuelingJP x = a + b + c;`
+    /// and `x = a + b + c;` work as they would with eager addition.
+    /// @param [in] sumExpr The addition expression to evaluate.
+    template <class LeftExpr, class RightExpr>
+    BasicDuelingJP(const DuelingJPSum<LeftExpr, RightExpr> &sumExpr);
 
 
     /// DuelingJP overloaded assignment operator assigns a duplicate of the
-    /// contents of one DuelingJP object to another.
+    /// contents of one DuelingJP object to another. The JumpPrime objects
+    /// are shared with the source until either object is modified.
     /// @param [in] sourceObject  The DuelingJP object to copy.
     /// @return A pointer to the new DuelingJP object.
-    DuelingJP &operator=(const DuelingJP & sourceObject);
+    BasicDuelingJP &operator=(const BasicDuelingJP & sourceObject);
 
     /// DuelingJP overloaded move assignment operator swaps the contents
     /// of one DuelingJP to another.
     /// @param sourceObject
     /// @return A pointer to the DuelingJP object with the content.
-    DuelingJP &operator=(DuelingJP && sourceObject);
+    BasicDuelingJP &operator=(BasicDuelingJP && sourceObject);
+
+    /// DuelingJP expression assignment operator evaluates an addition
+    /// expression into this DuelingJP object. The expression may refer to
+    /// this object.
+    /// @param [in] sumExpr The addition expression to evaluate.
+    /// @return A reference to this DuelingJP object.
+    template <class LeftExpr, class RightExpr>
+    BasicDuelingJP &operator=(const DuelingJPSum<LeftExpr, RightExpr> &sumExpr);
 
     /**
      * Compares two DuelingJP objects. Two DuelingJP objects are considered
@@ -123,7 +353,7 @@ public:
      * @param compareObject the DuelingJP to compare to.
      * @return true if equal, false otherwise.
      */
-    bool operator==(const DuelingJP& compareObject) const;
+    bool operator==(const BasicDuelingJP& compareObject) const;
 
     /**
      * Compares two DuelingJP objects. Two DuelingJP objects are considered
@@ -131,7 +361,7 @@ public:
      * @param compareObject the DuelingJP to compare to.
      * @return true if not equal, false otherwise.
      */
-    bool operator!=(const DuelingJP& compareObject) const;
+    bool operator!=(const BasicDuelingJP& compareObject) const;
 
     /**
      * Compares two DuelingJP objects. A DuelingJP object is considered
@@ -139,7 +369,7 @@ public:
      * @param compareObject the object to compare
      * @return true if the LHS is greater in size, false otherwise
      */
-    bool operator>(const DuelingJP& compareObject) const;
+    bool operator>(const BasicDuelingJP& compareObject) const;
 
     /**
      * Compares two DuelingJP objects. A DuelingJP object is considered
@@ -148,7 +378,7 @@ public:
      * @param compareObject the object to compare
      * @return true if the LHS is greater than or equal in size, false otherwise
      */
-    bool operator>=(const DuelingJP& compareObject) const;
+    bool operator>=(const BasicDuelingJP& compareObject) const;
 
     /**
      * Compares two DuelingJP objects. A DuelingJP object is considered
@@ -156,7 +386,7 @@ public:
      * @param compareObject the object to compare
      * @return true if the LHS is lesser in size, false otherwise
      */
-    bool operator<(const DuelingJP& compareObject) const;
+    bool operator<(const BasicDuelingJP& compareObject) const;
 
     /**
      * Compares two DuelingJP objects. A DuelingJP object is considered
@@ -165,37 +395,31 @@ public:
      * @param compareObject the object to compare
      * @return true if the LHS is less than or equal in size, false otherwise
      */
-    bool operator<=(const DuelingJP& compareObject) const;
+    bool operator<=(const BasicDuelingJP& compareObject) const;
 
     /**
      * Adds the contents of two DuelingJP objects together. The resulting
      * DuelingJP object will contain an array of JumpPrime objects that
      * encapsulate the same number as the originating DuelingJP objects.
      * @param addObject the DuelingJP to add to the operand.
-     * @return a new DuelingJP object with a list of JumpPrime objects made
-     * from the encapsulated numbers of the component DuelingJP objects.
+     * @return an addition expression that evaluates to a new DuelingJP object
+     * with a list of JumpPrime objects made from the encapsulated numbers,
+     * jump values and jump bounds of the component DuelingJP objects.
      */
-    DuelingJP operator+(const DuelingJP& addObject) const;
+    DuelingJPSum<DuelingJPTerm<Traits>, DuelingJPTerm<Traits>>
+    operator+(const BasicDuelingJP& addObject) const;
 
     /**
      * Adds a JumpPrime object to the contents of a DuelingJP object. This
      * yields a new DuelingJP object with a size increased by one.
      * @param addJP the JumpPrime object to add to the DuelingJP object.
-     * @return a new DuelingJP object with a list of JumpPrime objects made
-     * from the encapsulated numbers of the component DuelingJP object and
-     * the JumpPrime object.
-     */
-    DuelingJP operator+(const JumpPrime& addJP) const;
-
-    /**
-     * Adds the contents of a DuelingJP object to a JumpPrime object. This
-     * yields a new DuelingJP object with a size increased by one.
-     * @param addJP the JumpPrime object to add to the DuelingJP object.
-     * @return a new DuelingJP object with a list of JumpPrime objects made
-     * from the JumpPrime object and the encapsulated numbers of the component
-     * DuelingJP object.
+     * @return an addition expression that evaluates to a new DuelingJP object
+     * with a list of JumpPrime objects made from the encapsulated numbers,
+     * jump values and jump bounds of the component DuelingJP object and the
+     * JumpPrime object.
      */
-    friend DuelingJP operator+(const JumpPrime& addJP, const DuelingJP& addDJP);
+    DuelingJPSum<DuelingJPTerm<Traits>, JumpPrimeTerm<Traits>>
+    operator+(const Jumper& addJP) const;
 
     /**
      * Add the contents of a DuelingJP object to the existing object.
@@ -205,7 +429,17 @@ public:
      * @param addObject the DuelingJP object to add
      * @return a reference to the LHS DuelingJP object
      */
-    DuelingJP operator+=(const DuelingJP& addObject);
+    BasicDuelingJP operator+=(const BasicDuelingJP& addObject);
+
+    /**
+     * Add the result of an addition expression to the existing object. The
+     * existing JumpPrime objects are kept and new JumpPrime objects are
+     * built from the expression, all in a single new allocation.
+     * @param sumExpr the addition expression to add
+     * @return a reference to the LHS DuelingJP object
+     */
+    template <class LeftExpr, class RightExpr>
+    BasicDuelingJP operator+=(const DuelingJPSum<LeftExpr, RightExpr> &sumExpr);
 
 
 
@@ -214,8 +448,36 @@ public:
     /// the same value.
     /// @param [in] testUp If true, tests the JumpPrime objects in the "up"
     /// direction. Defaults to true.
+    /// @param [in,out] topOutputs If not nullptr, every result is also
+    /// added to this tracker.
     /// @return The number of JumpPrime objects that collided.
-    int countCollisions(bool testUp = true);
+    int countCollisions(bool testUp = true, TopKTracker *topOutputs = nullptr);
+
+    /// countCollisionsApprox makes the same single pass as countCollisions,
+    /// but estimates the number of collisions in 2^precision bytes. It is
+    /// exact for up to 2^precision / 16 distinct outputs; beyond that the
+    /// estimate's error is relative to the distinct count (see assumption
+    /// 10), not to the number of collisions.
+    /// @param [in] testUp If true, tests the JumpPrime objects in the "up"
+    /// direction. Defaults to true.
+    /// @param [in] precision The HyperLogLog precision; the sketch uses
+    /// 2^precision bytes.
+    /// @param [in,out] topOutputs If not nullptr, every result is also
+    /// added to this tracker.
+    /// @return The estimated number of JumpPrime objects that collided.
+    int countCollisionsApprox(bool testUp = true,
+                              int precision = HyperLogLog::DEFAULT_PRECISION,
+                              TopKTracker *topOutputs = nullptr);
+
+    /// sketchOutputs makes the same single pass as countCollisions, but
+    /// records every result in a HyperLogLog sketch instead of counting.
+    /// @param [in] testUp If true, queries the "up" direction, otherwise
+    /// the "down" direction.
+    /// @param [in,out] sketch The sketch to add the results to.
+    /// @param [in,out] topOutputs If not nullptr, every result is also
+    /// added to this tracker.
+    void sketchOutputs(bool testUp, HyperLogLog &sketch,
+                       TopKTracker *topOutputs = nullptr);
 
     /// countInversions will go through both the up() and down() methods of
     /// every JumpPrime object in the DuelingJP object and count the number
@@ -223,6 +485,80 @@ public:
     /// @return The number of JumpPrime object inversions.
     int countInversions();
 
+    /// countCollisionsPipelined counts the same collisions as
+    /// countCollisions, querying on generator threads and counting on
+    /// aggregator threads.
+    /// @param [in] testUp If true, tests the JumpPrime objects in the "up"
+    /// direction. Defaults to true.
+    /// @param [in] generatorThreads The threads querying JumpPrime objects;
+    /// 0 for half the cores.
+    /// @param [in] aggregatorThreads The threads counting outputs; 0 for
+    /// the rest of the cores.
+    /// @return The number of JumpPrime objects that collided.
+    int countCollisionsPipelined(bool testUp = true, int generatorThreads = 0,
+                                 int aggregatorThreads = 0);
+
+    /// countInversionsPipelined counts the same inversions as
+    /// countInversions, querying on generator threads and counting on
+    /// aggregator threads.
+    /// @param [in] generatorThreads The threads querying JumpPrime objects;
+    /// 0 for half the cores.
+    /// @param [in] aggregatorThreads The threads counting outputs; 0 for
+    /// the rest of the cores.
+    /// @return The number of JumpPrime object inversions.
+    int countInversionsPipelined(int generatorThreads = 0, int aggregatorThreads = 0);
+
+    /// queryOutputs makes the same single pass as countCollisions, but
+    /// records the result of every JumpPrime object instead of counting.
+    /// @param [in] testUp If true, queries the "up" direction, otherwise
+    /// the "down" direction.
+    /// @param [out] outputs Array of getSize() results, in jumper order.
+    void queryOutputs(bool testUp, Value *outputs);
+
+    /// queryInversionOutputs makes the same pass as countInversions (up()
+    /// then down() on each JumpPrime object), but records the results
+    /// instead of counting.
+    /// @param [out] upOutputs Array of getSize() up() results.
+    /// @param [out] downOutputs Array of getSize() down() results.
+    void queryInversionOutputs(Value *upOutputs, Value *downOutputs);
+
+    /// countInRange counts the JumpPrime objects whose encapsulated number
+    /// is in a closed range, in O(log n) once the index is built.
+    /// @param [in] low The smallest number counted.
+    /// @param [in] high The largest number counted.
+    /// @return The number of JumpPrime objects with low <= number <= high.
+    int countInRange(Value low, Value high) const;
+
+    /// nearestJumper finds the JumpPrime object whose encapsulated number
+    /// is closest to a target (the smaller number if two are equally
+    /// close), in O(log n) once the index is built.
+    /// @param [in] target The number to look near.
+    /// @return The position of that JumpPrime object, or -1 if this
+    /// DuelingJP is empty.
+    int nearestJumper(Value target) const;
+
+    /// getCurrentValue returns the encapsulated number of one JumpPrime
+    /// object, e.g. the one found by nearestJumper.
+    /// @param [in] jumperNumber The position of the JumpPrime object.
+    /// @pre 0 <= jumperNumber < getSize().
+    /// @return Its encapsulated number.
+    Value getCurrentValue(int jumperNumber) const;
+
+
+    /// resetAll resets every JumpPrime object to its initial number (a
+    /// failed object stays failed).
+    /// @return The number of JumpPrime objects active afterwards.
+    int resetAll();
+
+    /// reviveAll revives every deactivated JumpPrime object in place,
+    /// skipping words of the bitmap that are all active. Failed objects
+    /// are left as they are.
+    /// @return The number of JumpPrime objects active afterwards.
+    int reviveAll();
+
+    /// activeCount counts the active JumpPrime objects from the bitmap.
+    /// @return The number of active JumpPrime objects.
+    int activeCount() const;
 
     /// getSize returns the number of JumpPrime objects in this DuelingJP.
     /// @return The number of JumpPrime objects in the DuelingJP object.
@@ -232,5 +568,34 @@ public:
 
 };
 
+/**
+ * Adds the contents of a DuelingJP object to a JumpPrime object. This
+ * yields a new DuelingJP object with a size increased by one.
+ * @param addJP the JumpPrime object to add to the DuelingJP object.
+ * @return an addition expression that evaluates to a new DuelingJP object
+ * with a list of JumpPrime objects made from the JumpPrime object and the
+ * encapsulated numbers, jump values and jump bounds of the component
+ * DuelingJP object.
+ */
+template <class Traits>
+DuelingJPSum<JumpPrimeTerm<Traits>, DuelingJPTerm<Traits>>
+operator+(const BasicJumpPrime<Traits>& addJP,
+          const BasicDuelingJP<Traits>& addDJP);
+
+/// DuelingJP is the original configuration.
+typedef BasicDuelingJP<DefaultJumpTraits> DuelingJP;
+
+/// DuelingJP64 is the 64-bit configuration.
+typedef BasicDuelingJP<JumpTraits64> DuelingJP64;
+
+
+#include "DuelingJPImpl.h"
+#include "DuelingJPExpr.h"
+
+// the library compiles these configurations once (DuelingJP.cpp)
+extern template class BasicDuelingJP<DefaultJumpTraits>;
+extern template class BasicDuelingJP<MillerRabinJumpTraits>;
+extern template class BasicDuelingJP<JumpTraits64>;
+extern template class BasicDuelingJP<CachedJumpTraits>;
 
 #endif //INC_5011_P2_DUELINGJP_H
@@ -0,0 +1,442 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_DUELINGJPEXPR_H
+#define INC_5011_P4_DUELINGJPEXPR_H
+
+#include <memory>
+#include <new>
+#include <utility>
+#include "DuelingJP.h"
+
+/*
+ * Expression templates for DuelingJP addition.
+ *
+ * Adding DuelingJP and JumpPrime objects does not build a DuelingJP at each
+ * `+`. Instead each `+` returns a DuelingJPSum that records its two operands
+ * (a DuelingJPTerm, a JumpPrimeTerm or another DuelingJPSum). When the
+ * finished expression is used to construct or assign a DuelingJP, the total
+ * size is computed once, one array is allocated and every JumpPrime object
+ * is constructed in place from the recorded encapsulated numbers, jump
+ * values and jump bounds.
+ *
+ * A DuelingJPSum can otherwise be used as the DuelingJP it evaluates to, as
+ * when `+` returned a DuelingJP: it converts to one wherever a DuelingJP is
+ * expected, can be compared, assigned and added to, and has every public
+ * DuelingJP method. The first such use evaluates it into a DuelingJP that
+ * the expression keeps, so later uses see that object's state.
+ *
+ * ASSUMPTIONS:
+ * 1. A DuelingJPTerm holds a copy of its DuelingJP object. Copies share the
+ * JumpPrime array (see DuelingJP.h), so this is O(1), and an expression
+ * held in a variable stays valid however its operands change afterwards:
+ * it evaluates to the operands as they were at the `+`.
+ * 2. A JumpPrimeTerm copies the encapsulated number, jump value and jump
+ * bound of its JumpPrime object, so temporary JumpPrime operands (e.g.,
+ * djp + (jp1 + jp2)) are safe.
+ * 3. Evaluating an expression does not modify its operands.
+ * 4. Template functions that deduce the DuelingJP configuration from their
+ * argument do not accept an expression; convert it explicitly first (e.g.,
+ * DuelingJP(djp1 + djp2)).
+ */
+
+/// DuelingJPTerm is a leaf of an addition expression holding a DuelingJP
+/// object.
+template <class Traits>
+class DuelingJPTerm {
+
+    /// The DuelingJP object whose encapsulated numbers are added; shares
+    /// the operand's JumpPrime array.
+    BasicDuelingJP<Traits> source;
+
+public:
+
+    /// The configuration of the DuelingJP objects in the expression.
+    typedef Traits TraitsType;
+
+    /// DuelingJPTerm Constructor records a DuelingJP operand.
+    /// @param [in] sourceObject The DuelingJP operand.
+    explicit DuelingJPTerm(const BasicDuelingJP<Traits> &sourceObject)
+            : source(sourceObject) {}
+
+    /// getSize returns the number of JumpPrime objects this term adds.
+    /// @return The size of the DuelingJP operand.
+    int getSize() const {
+        return source.listSize;
+    }
+
+    /// construct builds a JumpPrime object for every encapsulated number of
+    /// the DuelingJP operand, keeping each object's jump value and bound.
+    /// @param [out] destination Uninitialized storage for getSize() objects.
+    void construct(BasicJumpPrime<Traits> *destination) const {
+        for (int i = 0; i < source.listSize; i++) {
+            const BasicJumpPrime<Traits> &jumper = source.jumperList[i];
+            new(&destination[i]) BasicJumpPrime<Traits>(
+                    jumper.getCurrentValue(), jumper.getJumpBound(),
+                    jumper.getJumpValue());
+        }
+    }
+};
+
+/// JumpPrimeTerm is a leaf of an addition expression holding the
+/// encapsulated number and jump settings of a JumpPrime object.
+template <class Traits>
+class JumpPrimeTerm {
+
+    /// The encapsulated number of the JumpPrime operand.
+    typename BasicJumpPrime<Traits>::Value value;
+
+    /// The jump bound of the JumpPrime operand.
+    unsigned int jumpBound;
+
+    /// The jump value of the JumpPrime operand.
+    int jumpValue;
+
+public:
+
+    /// The configuration of the DuelingJP objects in the expression.
+    typedef Traits TraitsType;
+
+    /// JumpPrimeTerm Constructor records a JumpPrime operand.
+    /// @param [in] sourceJP The JumpPrime operand.
+    explicit JumpPrimeTerm(const BasicJumpPrime<Traits> &sourceJP)
+            : value(sourceJP.getCurrentValue()),
+              jumpBound(sourceJP.getJumpBound()),
+              jumpValue(sourceJP.getJumpValue()) {}
+
+    /// getSize returns the number of JumpPrime objects this term adds.
+    /// @return Always one.
+    int getSize() const {
+        return 1;
+    }
+
+    /// construct builds the JumpPrime object for this term.
+    /// @param [out] destination Uninitialized storage for one object.
+    void construct(BasicJumpPrime<Traits> *destination) const {
+        new(destination) BasicJumpPrime<Traits>(value, jumpBound, jumpValue);
+    }
+};
+
+/// DuelingJPSum is an unevaluated addition of two expressions. Converting
+/// it to a DuelingJP object evaluates the whole chain at once; using it as
+/// a DuelingJP in any other way evaluates it once and keeps the result.
+template <class LeftExpr, class RightExpr>
+class DuelingJPSum {
+
+public:
+
+    /// The configuration of the DuelingJP objects in the expression.
+    typedef typename LeftExpr::TraitsType TraitsType;
+
+    /// The DuelingJP type the expression evaluates to.
+    typedef BasicDuelingJP<TraitsType> Result;
+
+    /// The type of the encapsulated numbers and of the query results.
+    typedef typename Result::Value Value;
+
+private:
+
+    /// The DuelingJP constructor, assignment and += read evaluated.
+    template <class ResultTraits> friend class BasicDuelingJP;
+
+    /// The left-hand operand.
+    LeftExpr left;
+
+    /// The right-hand operand.
+    RightExpr right;
+
+    /// The evaluated DuelingJP object once the expression has been used as
+    /// one, otherwise nullptr.
+    mutable Result *evaluated;
+
+    /// result returns the evaluated DuelingJP object, evaluating the
+    /// expression the first time.
+    Result &result() const {
+        if (evaluated == nullptr) {
+            evaluated = new Result(*this);
+        }
+        return *evaluated;
+    }
+
+public:
+
+    /// DuelingJPSum Constructor records both operands of an addition.
+    /// @param [in] leftExpr The left-hand operand.
+    /// @param [in] rightExpr The right-hand operand.
+    DuelingJPSum(const LeftExpr &leftExpr, const RightExpr &rightExpr)
+            : left(leftExpr), right(rightExpr), evaluated(nullptr) {}
+
+    /// DuelingJPSum Copy Constructor copies the operands and, if the
+    /// source was evaluated, shares its evaluated DuelingJP (copy-on-write).
+    /// @param [in] sourceExpr The expression to copy.
+    DuelingJPSum(const DuelingJPSum &sourceExpr)
+            : left(sourceExpr.left), right(sourceExpr.right),
+              evaluated((sourceExpr.evaluated == nullptr) ? nullptr :
+                        new Result(*sourceExpr.evaluated)) {}
+
+    /// DuelingJPSum Move Constructor takes over an expression.
+    /// @param [in] sourceExpr The expression to move.
+    DuelingJPSum(DuelingJPSum &&sourceExpr)
+            : left(std::move(sourceExpr.left)), right(std::move(sourceExpr.right)),
+              evaluated(sourceExpr.evaluated) {
+        sourceExpr.evaluated = nullptr;
+    }
+
+    /// DuelingJPSum Destructor releases the evaluated DuelingJP, if any.
+    ~DuelingJPSum() {
+        delete evaluated;
+    }
+
+    /// DuelingJPSum assignment operator makes the expression stand for a
+    /// DuelingJP object, as assigning to a DuelingJP would.
+    /// @param [in] sourceObject The DuelingJP object (or an expression,
+    /// converted) to assign.
+    /// @return A reference to this expression.
+    DuelingJPSum &operator=(const Result &sourceObject) {
+        result() = sourceObject;
+        return *this;
+    }
+
+    /// DuelingJPSum copy assignment operator; see operator=(const Result &).
+    DuelingJPSum &operator=(const DuelingJPSum &sourceExpr) {
+        if (this != &sourceExpr) {
+            result() = Result(sourceExpr);
+        }
+        return *this;
+    }
+
+    /// getSize returns the number of JumpPrime objects the evaluated
+    /// DuelingJP object contains, without evaluating the expression.
+    /// @return The combined size of both operands.
+    int getSize() const {
+        if (evaluated != nullptr) {
+            return evaluated->getSize();
+        }
+        return left.getSize() + right.getSize();
+    }
+
+    /// construct builds a JumpPrime object for every encapsulated number of
+    /// the expression in order, left operand first.
+    /// @param [out] destination Uninitialized storage for getSize() objects.
+    void construct(BasicJumpPrime<TraitsType> *destination) const {
+        if (evaluated != nullptr) {
+            // as when + read the numbers of the DuelingJP it returned
+            DuelingJPTerm<TraitsType>(*evaluated).construct(destination);
+            return;
+        }
+        left.construct(destination);
+        right.construct(destination + left.getSize());
+    }
+
+    // The rest of the DuelingJP interface, on the evaluated object.
+
+    bool operator==(const Result &compareObject) const {
+        return result() == compareObject;
+    }
+    bool operator!=(const Result &compareObject) const {
+        return result() != compareObject;
+    }
+    bool operator>(const Result &compareObject) const {
+        return result() > compareObject;
+    }
+    bool operator>=(const Result &compareObject) const {
+        return result() >= compareObject;
+    }
+    bool operator<(const Result &compareObject) const {
+        return result() < compareObject;
+    }
+    bool operator<=(const Result &compareObject) const {
+        return result() <= compareObject;
+    }
+
+    Result operator+=(const Result &addObject) {
+        return result() += addObject;
+    }
+    template <class OtherLeft, class OtherRight>
+    Result operator+=(const DuelingJPSum<OtherLeft, OtherRight> &sumExpr) {
+        return result() += sumExpr;
+    }
+
+    int countCollisions(bool testUp = true, TopKTracker *topOutputs = nullptr) {
+        return result().countCollisions(testUp, topOutputs);
+    }
+    int countCollisionsApprox(bool testUp = true,
+                              int precision = HyperLogLog::DEFAULT_PRECISION,
+                              TopKTracker *topOutputs = nullptr) {
+        return result().countCollisionsApprox(testUp, precision, topOutputs);
+    }
+    void sketchOutputs(bool testUp, HyperLogLog &sketch,
+                       TopKTracker *topOutputs = nullptr) {
+        result().sketchOutputs(testUp, sketch, topOutputs);
+    }
+    int countInversions() {
+        return result().countInversions();
+    }
+    int countCollisionsPipelined(bool testUp = true, int generatorThreads = 0,
+                                 int aggregatorThreads = 0) {
+        return result().countCollisionsPipelined(testUp, generatorThreads,
+                                                 aggregatorThreads);
+    }
+    int countInversionsPipelined(int generatorThreads = 0, int aggregatorThreads = 0) {
+        return result().countInversionsPipelined(generatorThreads, aggregatorThreads);
+    }
+    void queryOutputs(bool testUp, Value *outputs) {
+        result().queryOutputs(testUp, outputs);
+    }
+    void queryInversionOutputs(Value *upOutputs, Value *downOutputs) {
+        result().queryInversionOutputs(upOutputs, downOutputs);
+    }
+    int countInRange(Value low, Value high) const {
+        return result().countInRange(low, high);
+    }
+    int nearestJumper(Value target) const {
+        return result().nearestJumper(target);
+    }
+    Value getCurrentValue(int jumperNumber) const {
+        return result().getCurrentValue(jumperNumber);
+    }
+    int resetAll() {
+        return result().resetAll();
+    }
+    int reviveAll() {
+        return result().reviveAll();
+    }
+    int activeCount() const {
+        return result().activeCount();
+    }
+};
+
+
+template <class Traits>
+inline DuelingJPSum<DuelingJPTerm<Traits>, DuelingJPTerm<Traits>>
+BasicDuelingJP<Traits>::operator+(const BasicDuelingJP &addObject) const {
+    return {DuelingJPTerm<Traits>(*this), DuelingJPTerm<Traits>(addObject)};
+}
+
+template <class Traits>
+inline DuelingJPSum<DuelingJPTerm<Traits>, JumpPrimeTerm<Traits>>
+BasicDuelingJP<Traits>::operator+(const Jumper &addJP) const {
+    return {DuelingJPTerm<Traits>(*this), JumpPrimeTerm<Traits>(addJP)};
+}
+
+template <class Traits>
+inline DuelingJPSum<JumpPrimeTerm<Traits>, DuelingJPTerm<Traits>>
+operator+(const BasicJumpPrime<Traits> &addJP,
+          const BasicDuelingJP<Traits> &addDJP) {
+    return {JumpPrimeTerm<Traits>(addJP), DuelingJPTerm<Traits>(addDJP)};
+}
+
+/// Extends an addition expression with a DuelingJP operand.
+template <class Traits, class LeftExpr, class RightExpr>
+DuelingJPSum<DuelingJPSum<LeftExpr, RightExpr>, DuelingJPTerm<Traits>>
+operator+(const DuelingJPSum<LeftExpr, RightExpr> &sumExpr,
+          const BasicDuelingJP<Traits> &addDJP) {
+    return {sumExpr, DuelingJPTerm<Traits>(addDJP)};
+}
+
+/// Extends an addition expression with a JumpPrime operand.
+template <class Traits, class LeftExpr, class RightExpr>
+DuelingJPSum<DuelingJPSum<LeftExpr, RightExpr>, JumpPrimeTerm<Traits>>
+operator+(const DuelingJPSum<LeftExpr, RightExpr> &sumExpr,
+          const BasicJumpPrime<Traits> &addJP) {
+    return {sumExpr, JumpPrimeTerm<Traits>(addJP)};
+}
+
+/// Prepends a DuelingJP operand to an addition expression.
+template <class Traits, class LeftExpr, class RightExpr>
+DuelingJPSum<DuelingJPTerm<Traits>, DuelingJPSum<LeftExpr, RightExpr>>
+operator+(const BasicDuelingJP<Traits> &addDJP,
+          const DuelingJPSum<LeftExpr, RightExpr> &sumExpr) {
+    return {DuelingJPTerm<Traits>(addDJP), sumExpr};
+}
+
+/// Prepends a JumpPrime operand to an addition expression.
+template <class Traits, class LeftExpr, class RightExpr>
+DuelingJPSum<JumpPrimeTerm<Traits>, DuelingJPSum<LeftExpr, RightExpr>>
+operator+(const BasicJumpPrime<Traits> &addJP,
+          const DuelingJPSum<LeftExpr, RightExpr> &sumExpr) {
+    return {JumpPrimeTerm<Traits>(addJP), sumExpr};
+}
+
+/// Adds two addition expressions together.
+template <class LeftA, class RightA, class LeftB, class RightB>
+DuelingJPSum<DuelingJPSum<LeftA, RightA>, DuelingJPSum<LeftB, RightB>>
+operator+(const DuelingJPSum<LeftA, RightA> &leftExpr,
+          const DuelingJPSum<LeftB, RightB> &rightExpr) {
+    return {leftExpr, rightExpr};
+}
+
+
+template <class Traits>
+template <class LeftExpr, class RightExpr>
+BasicDuelingJP<Traits>::BasicDuelingJP(
+        const DuelingJPSum<LeftExpr, RightExpr> &sumExpr) {
+
+    // an expression already used as a DuelingJP converts to that object
+    if (sumExpr.evaluated != nullptr) {
+        jumperStore = sumExpr.evaluated->jumperStore;
+        jumperList = sumExpr.evaluated->jumperList;
+        listSize = sumExpr.evaluated->listSize;
+
+        if (jumperStore != nullptr) {
+            jumperStore->refCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    listSize = sumExpr.getSize();
+    jumperStore = allocateStore(listSize);
+    jumperList = jumperStore->jumpers;
+
+    sumExpr.construct(jumperList);
+    rebuildActivity();
+}
+
+template <class Traits>
+template <class LeftExpr, class RightExpr>
+BasicDuelingJP<Traits> &BasicDuelingJP<Traits>::operator=(
+        const DuelingJPSum<LeftExpr, RightExpr> &sumExpr) {
+
+    if (sumExpr.evaluated != nullptr) {
+        return *this = *sumExpr.evaluated;
+    }
+
+    // build the new list before releasing the old one, since the
+    // expression may hold this object's list
+    int newSize = sumExpr.getSize();
+    JumperStore *newStore = allocateStore(newSize);
+    sumExpr.construct(newStore->jumpers);
+
+    adoptStore(newStore, newSize);
+    rebuildActivity();
+
+    return *this;
+}
+
+template <class Traits>
+template <class LeftExpr, class RightExpr>
+BasicDuelingJP<Traits> BasicDuelingJP<Traits>::operator+=(
+        const DuelingJPSum<LeftExpr, RightExpr> &sumExpr) {
+
+    // as when adding the DuelingJP the expression was used as
+    if (sumExpr.evaluated != nullptr) {
+        return *this += *sumExpr.evaluated;
+    }
+
+    int newSize = this->listSize + sumExpr.getSize();
+    JumperStore *newStore = allocateStore(newSize);
+
+    std::uninitialized_copy(this->jumperList,
+                            this->jumperList + this->listSize,
+                            newStore->jumpers);
+    sumExpr.construct(newStore->jumpers + this->listSize);
+
+    adoptStore(newStore, newSize);
+    rebuildActivity();
+
+    return *this;
+}
+
+
+#endif //INC_5011_P4_DUELINGJPEXPR_H
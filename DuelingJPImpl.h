@@ -0,0 +1,700 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_DUELINGJPIMPL_H
+#define INC_5011_P4_DUELINGJPIMPL_H
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <sys/mman.h>
+#include "DuelingJP.h"
+#include "HotPathCounters.h"
+#include "LatencyHistogram.h"
+#include "TraceEvents.h"
+
+// Member definitions of BasicDuelingJP, included at the end of DuelingJP.h.
+
+
+template <class Traits>
+bool BasicDuelingJP<Traits>::testJumper(int jumperNumber) {
+    if (!jumperList[jumperNumber].isActive()) {
+        return jumperList[jumperNumber].revive();
+    }
+
+    return true;
+}
+
+
+template <class Traits>
+typename BasicDuelingJP<Traits>::JumperStore *
+BasicDuelingJP<Traits>::allocateStore(int size) {
+    // JumpPrime objects in a JumperStore are released without running
+    // their destructors
+    static_assert(std::is_trivially_destructible<Jumper>::value,
+                  "JumpPrime must be trivially destructible");
+
+    // JumpPrime objects are constructed in place by the caller so that no
+    // default JumpPrime (and its prime search) is ever built and discarded
+    JumperStore *newStore = new JumperStore;
+    newStore->refCount.store(1, std::memory_order_relaxed);
+    newStore->jumpers = static_cast<Jumper *>(
+            ::operator new(sizeof(Jumper) * (size > 0 ? size : 1)));
+    newStore->mappedBase = nullptr;
+    newStore->mappedLength = 0;
+    newStore->valueIndex.store(nullptr, std::memory_order_relaxed);
+    newStore->activeBits = allocateActivity(size);
+
+    return newStore;
+}
+
+template <class Traits>
+int BasicDuelingJP<Traits>::activityWords(int size) {
+    return (size + ACTIVITY_WORD_BITS - 1) / ACTIVITY_WORD_BITS;
+}
+
+template <class Traits>
+std::uint64_t *BasicDuelingJP<Traits>::allocateActivity(int size) {
+    return new std::uint64_t[std::max(activityWords(size), 1)]();
+}
+
+template <class Traits>
+void BasicDuelingJP<Traits>::rebuildActivity() {
+    for (int word = 0; word < activityWords(listSize); word++) {
+        int first = word * ACTIVITY_WORD_BITS;
+        int count = std::min(ACTIVITY_WORD_BITS, listSize - first);
+
+        std::uint64_t bits = 0;
+        for (int k = 0; k < count; k++) {
+            bits |= static_cast<std::uint64_t>(jumperList[first + k].isActive()) << k;
+        }
+        jumperStore->activeBits[word] = bits;
+    }
+}
+
+template <class Traits>
+template <class Visitor>
+void BasicDuelingJP<Traits>::queryWords(int firstWord, int lastWord, bool testUp,
+                                        Visitor visit) {
+    for (int word = firstWord; word < lastWord; word++) {
+        int first = word * ACTIVITY_WORD_BITS;
+        int count = std::min(ACTIVITY_WORD_BITS, listSize - first);
+        std::uint64_t fullWord = (count == ACTIVITY_WORD_BITS) ?
+                                 ~std::uint64_t(0) : ((std::uint64_t(1) << count) - 1);
+
+        // the check is the same for the whole word, so this is one
+        // predictable branch rather than an isActive() test per object
+        bool allActive = (jumperStore->activeBits[word] == fullWord);
+
+        std::uint64_t stillActive = 0;
+        for (int k = 0; k < count; k++) {
+            Jumper &jumper = jumperList[first + k];
+            if (!allActive) {
+                testJumper(first + k);
+            }
+            visit(first + k, testUp ? jumper.up() : jumper.down());
+            stillActive |= static_cast<std::uint64_t>(jumper.isActive()) << k;
+        }
+        jumperStore->activeBits[word] = stillActive;
+    }
+}
+
+template <class Traits>
+template <class Visitor>
+void BasicDuelingJP<Traits>::queryInversionWords(int firstWord, int lastWord,
+                                                 Visitor visit) {
+    for (int word = firstWord; word < lastWord; word++) {
+        int first = word * ACTIVITY_WORD_BITS;
+        int count = std::min(ACTIVITY_WORD_BITS, listSize - first);
+        std::uint64_t fullWord = (count == ACTIVITY_WORD_BITS) ?
+                                 ~std::uint64_t(0) : ((std::uint64_t(1) << count) - 1);
+        bool allActive = (jumperStore->activeBits[word] == fullWord);
+
+        std::uint64_t stillActive = 0;
+        for (int k = 0; k < count; k++) {
+            Jumper &jumper = jumperList[first + k];
+
+            // In case the JumpPrime was inactive
+            if (!allActive) {
+                testJumper(first + k);
+            }
+            Value upResult = jumper.up();
+
+            // In case the up jump deactivated it
+            testJumper(first + k);
+            Value downResult = jumper.down();
+
+            visit(first + k, upResult, downResult);
+            stillActive |= static_cast<std::uint64_t>(jumper.isActive()) << k;
+        }
+        jumperStore->activeBits[word] = stillActive;
+    }
+}
+
+template <class Traits>
+void BasicDuelingJP<Traits>::adoptStore(JumperStore *newStore, int size) {
+    releaseStore();
+
+    jumperStore = newStore;
+    jumperList = newStore->jumpers;
+    listSize = size;
+}
+
+template <class Traits>
+void BasicDuelingJP<Traits>::releaseStore() {
+    if (jumperStore != nullptr) {
+        // the last owner frees the store; acq_rel makes every other owner's
+        // reads of the array happen before the delete
+        if (jumperStore->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (jumperStore->mappedBase != nullptr) {
+                munmap(jumperStore->mappedBase, jumperStore->mappedLength);
+            } else {
+                ::operator delete(jumperStore->jumpers);
+            }
+            delete jumperStore->valueIndex.load(std::memory_order_relaxed);
+            delete[] jumperStore->activeBits;
+            delete jumperStore;
+        }
+    }
+
+    jumperStore = nullptr;
+    jumperList = nullptr;
+    listSize = 0;
+}
+
+template <class Traits>
+void BasicDuelingJP<Traits>::detach() {
+    if ((jumperStore != nullptr) &&
+        (jumperStore->refCount.load(std::memory_order_acquire) > 1)) {
+
+        JumperStore *newStore = allocateStore(listSize);
+        std::uninitialized_copy(jumperList, jumperList + listSize,
+                                newStore->jumpers);
+        std::copy(jumperStore->activeBits,
+                  jumperStore->activeBits + activityWords(listSize),
+                  newStore->activeBits);
+
+        adoptStore(newStore, listSize);
+    }
+
+    // a copied store starts without an index; an index of a store that
+    // was not shared stays and is brought up to date by updateIndex
+}
+
+template <class Traits>
+void BasicDuelingJP<Traits>::updateIndex() {
+    if (jumperStore == nullptr) {
+        return;
+    }
+
+    // the store is not shared here (detach came first), so no query can
+    // be reading the index
+    SortedValueIndex<Value> *index =
+            jumperStore->valueIndex.load(std::memory_order_relaxed);
+    if (index != nullptr) {
+        index->update(jumperList);
+    }
+}
+
+template <class Traits>
+const SortedValueIndex<typename BasicDuelingJP<Traits>::Value> *
+BasicDuelingJP<Traits>::sortedIndex() const {
+    if (jumperStore == nullptr) {
+        return nullptr;
+    }
+
+    SortedValueIndex<Value> *index =
+            jumperStore->valueIndex.load(std::memory_order_acquire);
+
+    if (index == nullptr) {
+        // copies sharing the store may build at the same time; the first
+        // to publish its index wins and the others discard theirs
+        SortedValueIndex<Value> *builtIndex =
+                new SortedValueIndex<Value>(jumperList, listSize);
+
+        if (jumperStore->valueIndex.compare_exchange_strong(
+                index, builtIndex, std::memory_order_acq_rel,
+                std::memory_order_acquire)) {
+            index = builtIndex;
+        } else {
+            delete builtIndex;
+        }
+    }
+
+    return index;
+}
+
+
+// assumption: all values in initValues are valid
+template <class Traits>
+BasicDuelingJP<Traits>::BasicDuelingJP(const int *initValues, int size,
+                                       unsigned int jumpBound, int jumpSize) {
+
+    jumperStore = allocateStore(size);
+    jumperList = jumperStore->jumpers;
+    listSize = size;
+
+    for (int i = 0; i < listSize; i++) {
+        new(&jumperList[i]) Jumper(initValues[i], jumpBound, jumpSize);
+    }
+    rebuildActivity();
+}
+
+
+// assumption: all values in initValues are valid
+template <class Traits>
+BasicDuelingJP<Traits>::BasicDuelingJP(const Value *initValues, int size,
+                                       unsigned int jumpBound, int jumpSize) {
+
+    jumperStore = allocateStore(size);
+    jumperList = jumperStore->jumpers;
+    listSize = size;
+
+    for (int i = 0; i < listSize; i++) {
+        new(&jumperList[i]) Jumper(initValues[i], jumpBound, jumpSize);
+    }
+    rebuildActivity();
+}
+
+
+template <class Traits>
+BasicDuelingJP<Traits>::BasicDuelingJP(JumperStore *newStore, int size) {
+    jumperStore = newStore;
+    jumperList = newStore->jumpers;
+    listSize = size;
+}
+
+
+template <class Traits>
+BasicDuelingJP<Traits>::~BasicDuelingJP() {
+    releaseStore();
+
+}
+
+
+template <class Traits>
+BasicDuelingJP<Traits>::BasicDuelingJP(const BasicDuelingJP &sourceObject) {
+
+    // share the source's list
+    jumperStore = sourceObject.jumperStore;
+    jumperList = sourceObject.jumperList;
+    listSize = sourceObject.listSize;
+
+    if (jumperStore != nullptr) {
+        jumperStore->refCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+}
+
+template <class Traits>
+BasicDuelingJP<Traits>::BasicDuelingJP(BasicDuelingJP &&sourceObject) {
+
+    // copy parameters
+    jumperStore = sourceObject.jumperStore;
+    listSize = sourceObject.listSize;
+    jumperList = sourceObject.jumperList;
+
+    // clear the source
+    sourceObject.jumperStore = nullptr;
+    sourceObject.listSize = 0;
+    sourceObject.jumperList = nullptr;
+
+
+
+}
+
+
+template <class Traits>
+BasicDuelingJP<Traits> &
+BasicDuelingJP<Traits>::operator=(const BasicDuelingJP &sourceObject) {
+
+    // check to verify they don't already share the same list
+    if (this->jumperStore != sourceObject.jumperStore) {
+
+        // take a reference to the new list before dropping the old one
+        if (sourceObject.jumperStore != nullptr) {
+            sourceObject.jumperStore->refCount.fetch_add(
+                    1, std::memory_order_relaxed);
+        }
+
+        releaseStore();
+
+        jumperStore = sourceObject.jumperStore;
+        jumperList = sourceObject.jumperList;
+        listSize = sourceObject.listSize;
+
+    }
+
+    // return the new list
+    return *this;
+
+}
+
+template <class Traits>
+BasicDuelingJP<Traits> &
+BasicDuelingJP<Traits>::operator=(BasicDuelingJP &&sourceObject) {
+
+    // swap contents
+    std::swap(jumperStore, sourceObject.jumperStore);
+    std::swap(listSize, sourceObject.listSize);
+    std::swap(jumperList, sourceObject.jumperList);
+
+
+
+    return *this;
+}
+
+template <class Traits>
+bool BasicDuelingJP<Traits>::operator==(const BasicDuelingJP &compareObject) const {
+    return (this->listSize == compareObject.listSize);
+}
+
+template <class Traits>
+bool BasicDuelingJP<Traits>::operator!=(const BasicDuelingJP &compareObject) const {
+    return !(*this == compareObject);
+}
+
+template <class Traits>
+bool BasicDuelingJP<Traits>::operator>(const BasicDuelingJP &compareObject) const {
+    return (this->listSize > compareObject.listSize);
+}
+
+template <class Traits>
+bool BasicDuelingJP<Traits>::operator>=(const BasicDuelingJP &compareObject) const {
+    return (this->listSize >= compareObject.listSize);
+}
+
+template <class Traits>
+bool BasicDuelingJP<Traits>::operator<(const BasicDuelingJP &compareObject) const {
+    return (this->listSize < compareObject.listSize);
+}
+
+template <class Traits>
+bool BasicDuelingJP<Traits>::operator<=(const BasicDuelingJP &compareObject) const {
+    return (this->listSize <= compareObject.listSize);
+}
+
+template <class Traits>
+BasicDuelingJP<Traits>
+BasicDuelingJP<Traits>::operator+=(const BasicDuelingJP &addObject) {
+    int newSize = this->listSize + addObject.listSize;
+    JumperStore *newStore = allocateStore(newSize);
+
+    std::uninitialized_copy(this->jumperList,
+                            this->jumperList + this->listSize,
+                            newStore->jumpers);
+    std::uninitialized_copy(addObject.jumperList,
+                            addObject.jumperList + addObject.listSize,
+                            newStore->jumpers + this->listSize);
+
+    // swap the newly constructed list with the old one (releasing it)
+    adoptStore(newStore, newSize);
+    rebuildActivity();
+
+    return *this;
+}
+
+template <class Traits>
+int BasicDuelingJP<Traits>::countCollisions(bool testUp,
+                                            TopKTracker *topOutputs) {
+    JP_COUNT(CollisionPasses);
+    JP_LATENCY_SCOPE(CollisionPass);
+    JP_TRACE_SCOPE(CollisionPass, listSize);
+
+    // the JumpPrime objects are about to be queried (and may jump)
+    detach();
+
+    struct CollisionCounter {
+        Value value = 0;
+        int count = 0;
+    };
+
+    CollisionCounter *collisionCounter = new CollisionCounter[listSize];
+
+
+    queryWords(0, activityWords(listSize), testUp, [&](int, Value outputValue) {
+        if (topOutputs != nullptr) {
+            topOutputs->add(outputValue);
+        }
+
+        /// For determining where in the count array to store count
+        int countIndex = 0;
+
+        // move through array until either a 0 value or equal value
+        while ((collisionCounter[countIndex].value > 0) &&
+               (collisionCounter[countIndex].value != outputValue)) {
+            countIndex++;
+        }
+
+        collisionCounter[countIndex].value = outputValue;
+        collisionCounter[countIndex].count++;
+
+    });
+    updateIndex();
+
+    // now count how many values had collisions
+    int returnCount = 0;
+
+    for (int i = 0; i < listSize; i++) {
+        if (collisionCounter[i].count > 0) {
+            returnCount = returnCount + collisionCounter[i].count - 1;
+        }
+    }
+
+    delete[] collisionCounter;
+
+    return returnCount;
+}
+
+template <class Traits>
+int BasicDuelingJP<Traits>::countCollisionsApprox(bool testUp, int precision,
+                                                  TopKTracker *topOutputs) {
+    HyperLogLog sketch(precision);
+    sketchOutputs(testUp, sketch, topOutputs);
+
+    // every output beyond the first of its value is a collision
+    long long distinct = std::llround(sketch.estimate());
+    return static_cast<int>(std::max(0LL, listSize - distinct));
+}
+
+template <class Traits>
+int BasicDuelingJP<Traits>::countInversions() {
+    JP_COUNT(InversionPasses);
+    JP_LATENCY_SCOPE(InversionPass);
+    JP_TRACE_SCOPE(InversionPass, listSize);
+
+    Value *upCount = new Value[listSize];
+    Value *downCount = new Value[listSize];
+
+    fillInversionOutputs(upCount, downCount);
+
+    int inversionCounter = 0;
+
+    {
+        JP_TRACE_SCOPE(MatchPhase, listSize);
+
+        for (int upTrack = 0; upTrack < listSize; upTrack++) {
+            for (int downTrack = 0; downTrack < listSize; downTrack++) {
+                if (upCount[upTrack] == downCount[downTrack]) {
+                    inversionCounter++;
+                }
+            }
+        }
+    }
+
+    delete[] upCount;
+    delete[] downCount;
+
+    return inversionCounter;
+}
+
+template <class Traits>
+int BasicDuelingJP<Traits>::countCollisionsPipelined(bool testUp, int generatorThreads,
+                                                     int aggregatorThreads) {
+    JP_COUNT(CollisionPasses);
+    JP_LATENCY_SCOPE(CollisionPass);
+    JP_TRACE_SCOPE(CollisionPass, listSize);
+
+    // the JumpPrime objects are about to be queried (and may jump)
+    detach();
+
+    CountingPipeline<Value> pipeline(generatorThreads, aggregatorThreads);
+    PipelineCounts counts = pipeline.run(
+            [this, testUp](int generatorNumber, int generatorCount,
+                           typename CountingPipeline<Value>::Emitter &emitter) {
+        // each generator queries its own contiguous share of the bitmap
+        // words, so no two generators write the same word
+        int wordCount = activityWords(listSize);
+        int firstWord = static_cast<int>(
+                static_cast<long long>(wordCount) * generatorNumber / generatorCount);
+        int lastWord = static_cast<int>(
+                static_cast<long long>(wordCount) * (generatorNumber + 1) / generatorCount);
+
+        queryWords(firstWord, lastWord, testUp, [&emitter](int, Value outputValue) {
+            emitter.emit(outputValue, false);
+        });
+    });
+    updateIndex();
+
+    // every output beyond the first of its value is a collision
+    return static_cast<int>(counts.upOutputs - counts.distinctUp);
+}
+
+template <class Traits>
+int BasicDuelingJP<Traits>::countInversionsPipelined(int generatorThreads,
+                                                     int aggregatorThreads) {
+    JP_COUNT(InversionPasses);
+    JP_LATENCY_SCOPE(InversionPass);
+    JP_TRACE_SCOPE(InversionPass, listSize);
+
+    // the JumpPrime objects are about to be queried (and may jump)
+    detach();
+
+    CountingPipeline<Value> pipeline(generatorThreads, aggregatorThreads);
+    PipelineCounts counts = pipeline.run(
+            [this](int generatorNumber, int generatorCount,
+                   typename CountingPipeline<Value>::Emitter &emitter) {
+        int wordCount = activityWords(listSize);
+        int firstWord = static_cast<int>(
+                static_cast<long long>(wordCount) * generatorNumber / generatorCount);
+        int lastWord = static_cast<int>(
+                static_cast<long long>(wordCount) * (generatorNumber + 1) / generatorCount);
+
+        // the same calls as fillInversionOutputs
+        queryInversionWords(firstWord, lastWord,
+                            [&emitter](int, Value upResult, Value downResult) {
+            emitter.emit(upResult, false);
+            emitter.emit(downResult, true);
+        });
+    });
+    updateIndex();
+
+    return static_cast<int>(counts.inversionPairs);
+}
+
+template <class Traits>
+void BasicDuelingJP<Traits>::queryOutputs(bool testUp, Value *outputs) {
+    JP_COUNT(CollisionPasses);
+    JP_LATENCY_SCOPE(CollisionPass);
+    JP_TRACE_SCOPE(CollisionPass, listSize);
+
+    // the JumpPrime objects are about to be queried (and may jump)
+    detach();
+
+    queryWords(0, activityWords(listSize), testUp, [outputs](int i, Value outputValue) {
+        outputs[i] = outputValue;
+    });
+    updateIndex();
+}
+
+template <class Traits>
+void BasicDuelingJP<Traits>::sketchOutputs(bool testUp, HyperLogLog &sketch,
+                                           TopKTracker *topOutputs) {
+    JP_COUNT(CollisionPasses);
+    JP_LATENCY_SCOPE(CollisionPass);
+    JP_TRACE_SCOPE(CollisionPass, listSize);
+
+    // the JumpPrime objects are about to be queried (and may jump)
+    detach();
+
+    queryWords(0, activityWords(listSize), testUp, [&](int, Value outputValue) {
+        sketch.add(outputValue);
+        if (topOutputs != nullptr) {
+            topOutputs->add(outputValue);
+        }
+    });
+    updateIndex();
+}
+
+template <class Traits>
+void BasicDuelingJP<Traits>::queryInversionOutputs(Value *upOutputs,
+                                                   Value *downOutputs) {
+    JP_COUNT(InversionPasses);
+    JP_LATENCY_SCOPE(InversionPass);
+    JP_TRACE_SCOPE(InversionPass, listSize);
+
+    fillInversionOutputs(upOutputs, downOutputs);
+}
+
+template <class Traits>
+void BasicDuelingJP<Traits>::fillInversionOutputs(Value *upOutputs,
+                                                  Value *downOutputs) {
+    JP_TRACE_SCOPE(QueryPhase, listSize);
+
+    // the JumpPrime objects are about to be queried (and may jump)
+    detach();
+
+    queryInversionWords(0, activityWords(listSize),
+                        [upOutputs, downOutputs](int i, Value upResult, Value downResult) {
+        upOutputs[i] = upResult;
+        downOutputs[i] = downResult;
+    });
+    updateIndex();
+}
+
+template <class Traits>
+int BasicDuelingJP<Traits>::countInRange(Value low, Value high) const {
+    const SortedValueIndex<Value> *index = sortedIndex();
+    return (index == nullptr) ? 0 : index->countInRange(low, high);
+}
+
+template <class Traits>
+int BasicDuelingJP<Traits>::nearestJumper(Value target) const {
+    const SortedValueIndex<Value> *index = sortedIndex();
+    return (index == nullptr) ? -1 : index->nearest(target);
+}
+
+template <class Traits>
+typename BasicDuelingJP<Traits>::Value
+BasicDuelingJP<Traits>::getCurrentValue(int jumperNumber) const {
+    return jumperList[jumperNumber].getCurrentValue();
+}
+
+template <class Traits>
+int BasicDuelingJP<Traits>::resetAll() {
+    // the JumpPrime objects are about to change
+    detach();
+
+    for (int i = 0; i < listSize; i++) {
+        jumperList[i].reset();
+    }
+    rebuildActivity();
+    updateIndex();
+
+    return activeCount();
+}
+
+template <class Traits>
+int BasicDuelingJP<Traits>::reviveAll() {
+    // nothing to revive: do not detach a shared store
+    if (activeCount() == listSize) {
+        return listSize;
+    }
+
+    detach();
+
+    for (int word = 0; word < activityWords(listSize); word++) {
+        int first = word * ACTIVITY_WORD_BITS;
+        int count = std::min(ACTIVITY_WORD_BITS, listSize - first);
+        std::uint64_t fullWord = (count == ACTIVITY_WORD_BITS) ?
+                                 ~std::uint64_t(0) : ((std::uint64_t(1) << count) - 1);
+
+        std::uint64_t inactiveBits = ~jumperStore->activeBits[word] & fullWord;
+        while (inactiveBits != 0) {
+            int k = __builtin_ctzll(inactiveBits);
+            inactiveBits &= inactiveBits - 1;
+
+            // revive() would permanently disable a failed object anyway
+            Jumper &jumper = jumperList[first + k];
+            if (!jumper.isDisabled() && jumper.revive()) {
+                jumperStore->activeBits[word] |= std::uint64_t(1) << k;
+            }
+        }
+    }
+
+    return activeCount();
+}
+
+template <class Traits>
+int BasicDuelingJP<Traits>::activeCount() const {
+    if (jumperStore == nullptr) {
+        return 0;
+    }
+
+    int count = 0;
+    for (int word = 0; word < activityWords(listSize); word++) {
+        count += __builtin_popcountll(jumperStore->activeBits[word]);
+    }
+    return count;
+}
+
+template <class Traits>
+int BasicDuelingJP<Traits>::getSize() const {
+    return listSize;
+}
+
+
+#endif //INC_5011_P4_DUELINGJPIMPL_H
@@ -0,0 +1,211 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "DuelingJPSnapshot.h"
+
+// the records are the in-memory JumpPrime objects
+static_assert(std::is_trivially_copyable<JumpPrime>::value,
+              "JumpPrime must be trivially copyable to be snapshotted");
+static_assert(std::is_standard_layout<JumpPrime>::value,
+              "JumpPrime must have a fixed layout to be snapshotted");
+static_assert(sizeof(JumpPrime) == 40,
+              "JumpPrime layout changed: update DuelingJPSnapshot::FORMAT_VERSION");
+
+
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = {'D', 'J', 'P', 'S', 'N', 'A', 'P', '\0'};
+const std::uint32_t BYTE_ORDER_MARKER = 0x01020304;
+
+/// SnapshotHeader is the fixed 64-byte header of a snapshot file.
+struct SnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    std::uint32_t recordSize;
+    std::uint32_t byteOrder;
+    std::uint64_t recordCount;
+    std::uint64_t recordChecksum;
+    std::uint64_t headerChecksum;
+    std::uint8_t reserved[16];
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "snapshot header must be 64 bytes");
+static_assert(offsetof(SnapshotHeader, headerChecksum) == 40,
+              "snapshot header layout changed");
+
+const std::uint64_t FNV_OFFSET = 0xcbf29ce484222325ull;
+const std::uint64_t FNV_PRIME = 0x100000001b3ull;
+
+/// continueChecksum extends an FNV-1a hash over 64-bit words, then any
+/// trailing bytes. Hashing two pieces one after the other gives the hash
+/// of both together as long as the first is a whole number of words.
+std::uint64_t continueChecksum(std::uint64_t hash, const void *data, std::size_t length) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+
+    std::size_t wordCount = length / sizeof(std::uint64_t);
+    for (std::size_t i = 0; i < wordCount; i++) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes + i * sizeof(word), sizeof(word));
+        hash = (hash ^ word) * FNV_PRIME;
+    }
+    for (std::size_t i = wordCount * sizeof(std::uint64_t); i < length; i++) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/// checksum computes FNV-1a over 64-bit words, then any trailing bytes.
+std::uint64_t checksum(const void *data, std::size_t length) {
+    return continueChecksum(FNV_OFFSET, data, length);
+}
+
+/// activityBytes returns the size of the activity bitmap for recordCount
+/// records.
+std::size_t activityBytes(std::uint64_t recordCount) {
+    return static_cast<std::size_t>((recordCount + 63) / 64) * sizeof(std::uint64_t);
+}
+
+/// isValidHeader checks everything in the header that does not require
+/// reading the records.
+bool isValidHeader(const SnapshotHeader &header, std::size_t fileSize) {
+    if ((std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) ||
+        (header.version != DuelingJPSnapshot::FORMAT_VERSION) ||
+        (header.headerSize != sizeof(SnapshotHeader)) ||
+        (header.recordSize != sizeof(JumpPrime)) ||
+        (header.byteOrder != BYTE_ORDER_MARKER)) {
+        return false;
+    }
+
+    if (header.headerChecksum !=
+        checksum(&header, offsetof(SnapshotHeader, headerChecksum))) {
+        return false;
+    }
+
+    // the record count must fit a DuelingJP and match the file size
+    if (header.recordCount > 0x7fffffffull) {
+        return false;
+    }
+    return fileSize == sizeof(SnapshotHeader) +
+                       header.recordCount * sizeof(JumpPrime) +
+                       activityBytes(header.recordCount);
+}
+
+} // namespace
+
+
+bool DuelingJPSnapshot::save(const DuelingJP &sourceObject, const char *path) {
+    std::size_t recordBytes =
+            static_cast<std::size_t>(sourceObject.listSize) * sizeof(JumpPrime);
+    std::size_t bitmapBytes = activityBytes(sourceObject.listSize);
+
+    // the checksum covers the records and the bitmap as they lie in the file
+    std::uint64_t recordChecksum = FNV_OFFSET;
+    if (recordBytes > 0) {
+        recordChecksum = checksum(sourceObject.jumperList, recordBytes);
+        recordChecksum = continueChecksum(recordChecksum,
+                                          sourceObject.jumperStore->activeBits,
+                                          bitmapBytes);
+    }
+
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = FORMAT_VERSION;
+    header.headerSize = sizeof(SnapshotHeader);
+    header.recordSize = sizeof(JumpPrime);
+    header.byteOrder = BYTE_ORDER_MARKER;
+    header.recordCount = static_cast<std::uint64_t>(sourceObject.listSize);
+    header.recordChecksum = recordChecksum;
+    header.headerChecksum =
+            checksum(&header, offsetof(SnapshotHeader, headerChecksum));
+
+    std::FILE *snapshotFile = std::fopen(path, "wb");
+    if (snapshotFile == nullptr) {
+        return false;
+    }
+
+    bool writeOk = (std::fwrite(&header, sizeof(header), 1, snapshotFile) == 1);
+    if (writeOk && (recordBytes > 0)) {
+        writeOk = (std::fwrite(sourceObject.jumperList, recordBytes, 1,
+                               snapshotFile) == 1) &&
+                  (std::fwrite(sourceObject.jumperStore->activeBits, bitmapBytes, 1,
+                               snapshotFile) == 1);
+    }
+
+    // fclose flushes, so its result counts too
+    bool closeOk = (std::fclose(snapshotFile) == 0);
+
+    return writeOk && closeOk;
+}
+
+bool DuelingJPSnapshot::load(const char *path, DuelingJP &targetObject,
+                             bool verifyChecksum) {
+    int fileDescriptor = open(path, O_RDONLY);
+    if (fileDescriptor < 0) {
+        return false;
+    }
+
+    struct stat fileStatus;
+    if ((fstat(fileDescriptor, &fileStatus) != 0) ||
+        (static_cast<std::size_t>(fileStatus.st_size) < sizeof(SnapshotHeader))) {
+        close(fileDescriptor);
+        return false;
+    }
+    std::size_t fileSize = static_cast<std::size_t>(fileStatus.st_size);
+
+    // a private writable mapping lets the DuelingJP object query (and so
+    // modify) its JumpPrime objects in place without touching the file
+    void *mappedBase = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE, fileDescriptor, 0);
+    close(fileDescriptor);
+    if (mappedBase == MAP_FAILED) {
+        return false;
+    }
+
+    SnapshotHeader header;
+    std::memcpy(&header, mappedBase, sizeof(header));
+    JumpPrime *records = reinterpret_cast<JumpPrime *>(
+            static_cast<char *>(mappedBase) + sizeof(SnapshotHeader));
+
+    bool validSnapshot = isValidHeader(header, fileSize);
+    if (validSnapshot && verifyChecksum) {
+        validSnapshot = (header.recordChecksum ==
+                         checksum(records, fileSize - sizeof(SnapshotHeader)));
+    }
+    if (!validSnapshot) {
+        munmap(mappedBase, fileSize);
+        return false;
+    }
+
+    DuelingJP::JumperStore *loadedStore = new DuelingJP::JumperStore;
+    loadedStore->refCount.store(1, std::memory_order_relaxed);
+    loadedStore->jumpers = records;
+    loadedStore->mappedBase = mappedBase;
+    loadedStore->mappedLength = fileSize;
+    loadedStore->valueIndex.store(nullptr, std::memory_order_relaxed);
+    int recordCount = static_cast<int>(header.recordCount);
+    loadedStore->activeBits = DuelingJP::allocateActivity(recordCount);
+    std::memcpy(loadedStore->activeBits, records + recordCount,
+                activityBytes(header.recordCount));
+
+    // bits past the last record must stay clear for activeCount
+    if (recordCount % DuelingJP::ACTIVITY_WORD_BITS != 0) {
+        loadedStore->activeBits[recordCount / DuelingJP::ACTIVITY_WORD_BITS] &=
+                (std::uint64_t(1) << (recordCount % DuelingJP::ACTIVITY_WORD_BITS)) - 1;
+    }
+
+    targetObject = DuelingJP(loadedStore, recordCount);
+
+    return true;
+}
@@ -0,0 +1,78 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_DUELINGJPSNAPSHOT_H
+#define INC_5011_P4_DUELINGJPSNAPSHOT_H
+
+#include <cstdint>
+#include "DuelingJP.h"
+
+
+/*
+ * DuelingJPSnapshot saves the complete state of a DuelingJP object to a
+ * binary file and loads it back without redoing any prime searches.
+ *
+ * FILE FORMAT (version 3, native byte order):
+ *   offset  size  field
+ *        0     8  magic "DJPSNAP" followed by a zero byte
+ *        8     4  format version
+ *       12     4  header size (64)
+ *       16     4  size of one JumpPrime record
+ *       20     4  byte order marker 0x01020304
+ *       24     8  number of JumpPrime records
+ *       32     8  checksum of the records and activity bitmap
+ *       40     8  checksum of bytes 0-39 of the header
+ *       48    16  reserved (zero)
+ *       64     -  the JumpPrime records, each the in-memory representation
+ *                 of a JumpPrime object (initial and current number,
+ *                 status, query count and limit, jump count and limit,
+ *                 jump value, upper and lower prime)
+ *        -     -  the activity bitmap of the DuelingJP object, one 64-bit
+ *                 word per 64 records (bit k of word w set if record
+ *                 64 * w + k is active)
+ *
+ * The checksums are FNV-1a computed over 64-bit words (trailing bytes one
+ * at a time).
+ *
+ * ASSUMPTIONS:
+ * 1. A snapshot is only loaded on a machine with the same byte order and
+ * JumpPrime layout as the one that saved it; the header is checked for both.
+ * 2. Loading maps the file privately (MAP_PRIVATE) and the DuelingJP object
+ * uses the records in place. Querying the loaded object copies only the
+ * pages it modifies; the file itself is never changed.
+ * 3. Checksum verification reads every page of the file. It can be skipped
+ * when the fastest possible restart matters more than detecting corruption;
+ * loading then reads only the header and the activity bitmap (one bit per
+ * record), never the records themselves.
+ */
+
+/// DuelingJPSnapshot saves and loads DuelingJP objects as binary snapshots.
+class DuelingJPSnapshot {
+
+public:
+
+    /// The current snapshot format version.
+    static const std::uint32_t FORMAT_VERSION = 3;
+
+    /// save writes the state of every JumpPrime object of a DuelingJP
+    /// object to a snapshot file, replacing any existing file.
+    /// @param [in] sourceObject The DuelingJP object to save.
+    /// @param [in] path The path of the snapshot file.
+    /// @return true if the snapshot was written completely.
+    static bool save(const DuelingJP &sourceObject, const char *path);
+
+    /// load maps a snapshot file and makes a DuelingJP object use its
+    /// JumpPrime records in place.
+    /// @param [in] path The path of the snapshot file.
+    /// @param [out] targetObject Receives the loaded DuelingJP object. It
+    /// is left unchanged if the load fails.
+    /// @param [in] verifyChecksum If true, the record checksum is verified.
+    /// @return true if the file is a valid snapshot and was loaded.
+    static bool load(const char *path, DuelingJP &targetObject,
+                     bool verifyChecksum = true);
+
+};
+
+
+#endif //INC_5011_P4_DUELINGJPSNAPSHOT_H
@@ -0,0 +1,176 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <map>
+#include <string>
+#include "ExperimentBatch.h"
+#include "ExperimentScheduler.h"
+
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/// The largest priority accepted.
+const int MAX_PRIORITY = 1000;
+
+/// parsePriorityList reads comma-separated priorities.
+/// @return false if the list is malformed or a priority is out of range.
+bool parsePriorityList(const char *listText, std::vector<int> &priorities) {
+    priorities.clear();
+    const char *position = listText;
+
+    while (true) {
+        char *end;
+        long priority = std::strtol(position, &end, 10);
+        if ((end == position) || (priority < 1) || (priority > MAX_PRIORITY)) {
+            return false;
+        }
+        priorities.push_back(static_cast<int>(priority));
+        position = end;
+
+        if (*position == '\0') {
+            return true;
+        }
+        if (*position != ',') {
+            return false;
+        }
+        position++;
+    }
+}
+
+/// PriorityShare is what the experiments of one priority received.
+struct PriorityShare {
+    int experiments = 0;
+    double runSeconds = 0;
+    double elapsedSeconds = 0;
+};
+
+} // namespace
+
+
+bool parseExperimentBatchConfig(int argc, char *argv[], ExperimentBatchConfig &config) {
+    for (int i = 0; i < argc; i++) {
+        std::string option = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char *value = argv[++i];
+
+        if (option == "--count") {
+            config.experiments = std::atoi(value);
+        } else if (option == "--population") {
+            config.population = std::atoi(value);
+        } else if (option == "--rounds") {
+            config.rounds = std::atoi(value);
+        } else if (option == "--distribution") {
+            if (!parseLoadDistribution(value, config.distribution)) {
+                return false;
+            }
+        } else if (option == "--priorities") {
+            if (!parsePriorityList(value, config.priorities)) {
+                return false;
+            }
+        } else if (option == "--workers") {
+            config.workers = std::atoi(value);
+        } else if (option == "--slice") {
+            config.sliceMicroseconds = std::atoi(value);
+        } else if (option == "--min-seed") {
+            config.minSeed = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+        } else if (option == "--max-seed") {
+            config.maxSeed = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+        } else if (option == "--seed") {
+            config.randomSeed = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+        } else {
+            return false;
+        }
+    }
+
+    // every seed must be a valid JumpPrime initial value
+    return (config.experiments >= 1) && (config.population >= 1) &&
+           (config.rounds >= 1) && (config.workers >= 0) &&
+           (config.sliceMicroseconds >= 1) &&
+           (config.minSeed >= 100) && (config.minSeed <= config.maxSeed) &&
+           (config.maxSeed <= 0x7fffffffu);
+}
+
+bool runExperimentBatch(const ExperimentBatchConfig &config, std::ostream &output) {
+    ExperimentScheduler scheduler(config.workers, config.sliceMicroseconds);
+
+    output << "Experiment batch: " << config.experiments << " experiments"
+           << ", population " << config.population
+           << ", rounds " << config.rounds
+           << ", workers " << scheduler.getWorkerCount() << "\n";
+
+    Clock::time_point start = Clock::now();
+
+    std::vector<std::future<ExperimentResult>> futures;
+    futures.reserve(config.experiments);
+    for (int e = 0; e < config.experiments; e++) {
+        LoadConfig loadConfig;
+        loadConfig.population = config.population;
+        loadConfig.distribution = config.distribution;
+        loadConfig.minSeed = config.minSeed;
+        loadConfig.maxSeed = config.maxSeed;
+        loadConfig.randomSeed = config.randomSeed + static_cast<unsigned int>(e);
+
+        ExperimentSpec spec;
+        spec.seeds.resize(config.population);
+        generateLoadSeeds(loadConfig, spec.seeds.data());
+        spec.rounds = config.rounds;
+        spec.priority = config.priorities[e % config.priorities.size()];
+
+        futures.push_back(scheduler.submit(spec));
+    }
+
+    long long upCollisions = 0;
+    long long downCollisions = 0;
+    long long inversions = 0;
+    bool allCompleted = true;
+    std::map<int, PriorityShare> shares;
+    for (int e = 0; e < config.experiments; e++) {
+        ExperimentResult result = futures[e].get();
+        allCompleted = allCompleted && result.completed;
+        upCollisions += result.upCollisions;
+        downCollisions += result.downCollisions;
+        inversions += result.inversions;
+
+        PriorityShare &share = shares[config.priorities[e % config.priorities.size()]];
+        share.experiments++;
+        share.runSeconds += result.runSeconds;
+        share.elapsedSeconds += result.elapsedSeconds;
+    }
+
+    std::chrono::duration<double> batchTime = Clock::now() - start;
+    scheduler.shutdown();
+
+    output << "Batch seconds: " << batchTime.count() << "\n";
+    output << "Totals: up collisions " << upCollisions
+           << ", down collisions " << downCollisions
+           << ", inversions " << inversions << "\n";
+    for (const std::pair<const int, PriorityShare> &share : shares) {
+        output << "Priority " << share.first << ": "
+               << share.second.experiments << " experiments, mean run "
+               << (share.second.runSeconds / share.second.experiments)
+               << " s, mean completion "
+               << (share.second.elapsedSeconds / share.second.experiments)
+               << " s\n";
+    }
+    ExperimentScheduler::printStats(scheduler.getStats(), output);
+
+    if (!allCompleted) {
+        output << "Some experiments did not complete\n";
+    }
+    return allCompleted;
+}
+
+void printExperimentBatchUsage(std::ostream &output) {
+    output << "usage: 5011_p4 --experiments [--count <n>] [--population <n>]"
+              " [--rounds <n>] [--distribution uniform|clustered|duplicate]"
+              " [--priorities <list>] [--workers <n>] [--slice <us>]"
+              " [--min-seed <n>] [--max-seed <n>] [--seed <n>]\n";
+}
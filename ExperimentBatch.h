@@ -0,0 +1,72 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_EXPERIMENTBATCH_H
+#define INC_5011_P4_EXPERIMENTBATCH_H
+
+#include <ostream>
+#include <vector>
+#include "LoadGenerator.h"
+
+
+/*
+ * The experiment batch runs many small, independent DuelingJP experiments
+ * through an ExperimentScheduler (see ExperimentScheduler.h), the way a
+ * service running thousands of experiments would, and reports the
+ * throughput of the worker pool per core.
+ *
+ * Experiment i draws its population as the load generator does (see
+ * LoadGenerator.h), from random seed randomSeed + i, and gets the priority
+ * at position i of the priority list (repeating the list as needed). All
+ * experiments are submitted at once and their futures are collected. The
+ * report totals the counts, shows how worker time was shared between the
+ * priorities and prints the scheduler's per-core and per-worker statistics.
+ *
+ * OPTIONS (after --experiments):
+ *   --count <n>             number of experiments (default 1000)
+ *   --population <n>        JumpPrime objects per experiment (default 100)
+ *   --rounds <n>            counting rounds per experiment (default 5)
+ *   --distribution <d>      uniform | clustered | duplicate (default uniform)
+ *   --priorities <list>     comma-separated priorities, cycled over the
+ *                           experiments (default 1)
+ *   --workers <n>           worker threads (default: one per core)
+ *   --slice <us>            time slice in microseconds (default 2000)
+ *   --min-seed <n>          smallest seed (default 1000)
+ *   --max-seed <n>          largest seed (default 100000)
+ *   --seed <n>              random seed of the first experiment (default 5011)
+ */
+
+/// ExperimentBatchConfig holds the settings of an experiment batch.
+struct ExperimentBatchConfig {
+    int experiments = 1000;
+    int population = 100;
+    int rounds = 5;
+    LoadDistribution distribution = LoadDistribution::Uniform;
+    std::vector<int> priorities = {1};
+    int workers = 0;
+    int sliceMicroseconds = 2000;
+    unsigned int minSeed = 1000;
+    unsigned int maxSeed = 100000;
+    unsigned int randomSeed = 5011;
+};
+
+/// parseExperimentBatchConfig reads experiment batch options.
+/// @param [in] argc The number of arguments in argv.
+/// @param [in] argv The options, not including --experiments itself.
+/// @param [out] config The parsed settings.
+/// @return true if every option was understood and valid.
+bool parseExperimentBatchConfig(int argc, char *argv[], ExperimentBatchConfig &config);
+
+/// runExperimentBatch runs the experiments and prints the report.
+/// @param [in] config The batch settings.
+/// @param [in] output The stream to print to.
+/// @return false if any experiment did not complete.
+bool runExperimentBatch(const ExperimentBatchConfig &config, std::ostream &output);
+
+/// printExperimentBatchUsage describes the experiment batch options.
+/// @param [in] output The stream to print to.
+void printExperimentBatchUsage(std::ostream &output);
+
+
+#endif //INC_5011_P4_EXPERIMENTBATCH_H
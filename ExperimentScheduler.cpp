@@ -0,0 +1,266 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <algorithm>
+#include <utility>
+#include "DuelingJP.h"
+#include "ExperimentScheduler.h"
+
+
+namespace {
+
+/// The operations of a round, in the order they run.
+enum RoundOperation {
+    UpCollisions, DownCollisions, Inversions, OPERATIONS_PER_ROUND
+};
+
+typedef std::chrono::steady_clock Clock;
+
+} // namespace
+
+
+struct ExperimentScheduler::ExperimentTask {
+    ExperimentSpec spec;
+    std::promise<ExperimentResult> promise;
+    ExperimentResult result;
+
+    /// The experiment's population; nullptr until the first step builds it.
+    DuelingJP *population = nullptr;
+
+    /// The round and the operation within it that run next.
+    int nextRound = 0;
+    int nextOperation = UpCollisions;
+
+    /// Worker nanoseconds run, divided by the priority.
+    double virtualRuntime = 0;
+
+    /// The submission number, ordering tasks of equal virtual run time.
+    long long sequence = 0;
+
+    Clock::time_point submitTime;
+};
+
+bool ExperimentScheduler::TaskOrder::operator()(const ExperimentTask *first,
+                                                const ExperimentTask *second) const {
+    // std::priority_queue keeps the greatest on top, so order in reverse
+    if (first->virtualRuntime != second->virtualRuntime) {
+        return first->virtualRuntime > second->virtualRuntime;
+    }
+    return first->sequence > second->sequence;
+}
+
+ExperimentScheduler::ExperimentScheduler(int workerThreads, int sliceMicroseconds) {
+    virtualClock = 0;
+    nextSequence = 0;
+    stopping = false;
+    experimentCount.store(0);
+    roundCount.store(0);
+    sliceCount.store(0);
+    queryCount.store(0);
+    stopped.store(false);
+    sliceLength = std::chrono::microseconds(std::max(1, sliceMicroseconds));
+
+    workerCount = workerThreads;
+    if (workerCount <= 0) {
+        workerCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    workerStats = new WorkerStats[workerCount];
+
+    startTime = Clock::now();
+    stopTime = startTime;
+    workers.reserve(workerCount);
+    for (int w = 0; w < workerCount; w++) {
+        workers.emplace_back(&ExperimentScheduler::runWorker, this, w);
+    }
+}
+
+ExperimentScheduler::~ExperimentScheduler() {
+    shutdown();
+    delete[] workerStats;
+}
+
+std::future<ExperimentResult> ExperimentScheduler::submit(const ExperimentSpec &spec) {
+    ExperimentTask *task = new ExperimentTask;
+    task->spec = spec;
+    task->spec.priority = std::max(1, spec.priority);
+    task->spec.rounds = std::max(0, spec.rounds);
+    task->submitTime = Clock::now();
+    std::future<ExperimentResult> future = task->promise.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (!stopping) {
+            task->virtualRuntime = virtualClock;
+            task->sequence = nextSequence++;
+            readyTasks.push(task);
+            task = nullptr;
+        }
+    }
+
+    if (task != nullptr) {
+        // too late to run: report it as not completed
+        task->promise.set_value(task->result);
+        delete task;
+    } else {
+        taskReady.notify_one();
+    }
+
+    return future;
+}
+
+void ExperimentScheduler::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (stopping) {
+            return;
+        }
+        stopping = true;
+    }
+    taskReady.notify_all();
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    stopTime = Clock::now();
+    stopped.store(true, std::memory_order_release);
+}
+
+int ExperimentScheduler::getWorkerCount() const {
+    return workerCount;
+}
+
+SchedulerStats ExperimentScheduler::getStats() const {
+    SchedulerStats stats;
+    stats.workers = workerCount;
+    stats.experiments = experimentCount.load(std::memory_order_relaxed);
+    stats.rounds = roundCount.load(std::memory_order_relaxed);
+    stats.slices = sliceCount.load(std::memory_order_relaxed);
+    stats.queries = queryCount.load(std::memory_order_relaxed);
+
+    Clock::time_point endTime = stopped.load(std::memory_order_acquire) ?
+                                stopTime : Clock::now();
+    stats.wallSeconds = std::chrono::duration<double>(endTime - startTime).count();
+
+    for (int w = 0; w < workerCount; w++) {
+        stats.workerBusySeconds.push_back(
+                workerStats[w].busyNanoseconds.load(std::memory_order_relaxed) * 1e-9);
+    }
+
+    return stats;
+}
+
+void ExperimentScheduler::printStats(const SchedulerStats &stats, std::ostream &output) {
+    double coreSeconds = stats.wallSeconds * std::max(1, stats.workers);
+
+    output << "Scheduler: " << stats.workers << " workers, "
+           << stats.experiments << " experiments, "
+           << stats.rounds << " rounds in " << stats.slices << " slices, "
+           << stats.wallSeconds << " seconds\n";
+    if (coreSeconds > 0) {
+        output << "Per core: " << (stats.experiments / coreSeconds) << " experiments/s, "
+               << (stats.rounds / coreSeconds) << " rounds/s, "
+               << (stats.queries / coreSeconds) << " queries/s\n";
+    }
+
+    for (std::size_t w = 0; w < stats.workerBusySeconds.size(); w++) {
+        double busy = stats.workerBusySeconds[w];
+        output << "Worker " << w << ": busy " << busy << " seconds";
+        if (stats.wallSeconds > 0) {
+            output << " (" << (100.0 * busy / stats.wallSeconds) << "%)";
+        }
+        output << "\n";
+    }
+}
+
+void ExperimentScheduler::runWorker(int workerNumber) {
+    while (true) {
+        ExperimentTask *task;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            taskReady.wait(lock, [this]() {
+                return stopping || !readyTasks.empty();
+            });
+
+            // a task still running elsewhere is requeued by its own
+            // worker, so an empty queue after shutdown means nothing is left
+            // for this one
+            if (readyTasks.empty()) {
+                return;
+            }
+
+            task = readyTasks.top();
+            readyTasks.pop();
+            virtualClock = std::max(virtualClock, task->virtualRuntime);
+        }
+
+        Clock::time_point sliceStart = Clock::now();
+        Clock::time_point sliceEnd;
+        bool finished;
+        do {
+            finished = runStep(*task);
+            sliceEnd = Clock::now();
+        } while (!finished && (sliceEnd - sliceStart < sliceLength));
+
+        std::chrono::nanoseconds ran = sliceEnd - sliceStart;
+        workerStats[workerNumber].busyNanoseconds.fetch_add(ran.count(),
+                                                            std::memory_order_relaxed);
+        sliceCount.fetch_add(1, std::memory_order_relaxed);
+        task->result.slices++;
+        task->result.runSeconds += ran.count() * 1e-9;
+        task->virtualRuntime += static_cast<double>(ran.count()) / task->spec.priority;
+
+        if (finished) {
+            task->result.completed = true;
+            task->result.elapsedSeconds =
+                    std::chrono::duration<double>(sliceEnd - task->submitTime).count();
+            delete task->population;
+            task->population = nullptr;
+
+            experimentCount.fetch_add(1, std::memory_order_relaxed);
+            task->promise.set_value(task->result);
+            delete task;
+        } else {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                readyTasks.push(task);
+            }
+            taskReady.notify_one();
+        }
+    }
+}
+
+bool ExperimentScheduler::runStep(ExperimentTask &task) {
+    if (task.population == nullptr) {
+        task.population = new DuelingJP(task.spec.seeds.data(),
+                                        static_cast<int>(task.spec.seeds.size()));
+        return (task.spec.rounds == 0);
+    }
+
+    long long size = task.population->getSize();
+    switch (task.nextOperation) {
+        case UpCollisions:
+            task.result.upCollisions += task.population->countCollisions(true);
+            queryCount.fetch_add(size, std::memory_order_relaxed);
+            break;
+        case DownCollisions:
+            task.result.downCollisions += task.population->countCollisions(false);
+            queryCount.fetch_add(size, std::memory_order_relaxed);
+            break;
+        default:
+            task.result.inversions += task.population->countInversions();
+            queryCount.fetch_add(2 * size, std::memory_order_relaxed);
+            break;
+    }
+
+    task.nextOperation++;
+    if (task.nextOperation == OPERATIONS_PER_ROUND) {
+        task.nextOperation = UpCollisions;
+        task.nextRound++;
+        task.result.rounds++;
+        roundCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return (task.nextRound >= task.spec.rounds);
+}
@@ -0,0 +1,218 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_EXPERIMENTSCHEDULER_H
+#define INC_5011_P4_EXPERIMENTSCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <ostream>
+#include <queue>
+#include <thread>
+#include <vector>
+
+
+/*
+ * The ExperimentScheduler runs many small, independent DuelingJP
+ * experiments on a fixed pool of worker threads, instead of a thread per
+ * experiment.
+ *
+ * An experiment is a population of seeds and a number of rounds; each
+ * round is countCollisions (up), countCollisions (down) and
+ * countInversions on the experiment's DuelingJP. The experiment is run as
+ * a continuation: it records which step of which round comes next, so a
+ * worker can run it for a time slice, put it back on the ready queue and
+ * pick up another experiment. Building the DuelingJP is the first step,
+ * so submitting an experiment costs the caller nothing but a queue push.
+ *
+ * Slices are shared fairly by virtual run time. Each experiment accumulates
+ * the time it has run, divided by its priority; a worker always takes the
+ * ready experiment with the least virtual run time. While several
+ * experiments are ready, one of priority 2 therefore gets about twice the
+ * worker time of one of priority 1, and a long experiment cannot starve
+ * short ones. A newly submitted experiment starts at the virtual run time
+ * of the experiments already running, so it neither waits behind them nor
+ * jumps ahead of them for long.
+ *
+ * METHODS:
+ * 1. submit queues an experiment and returns a future for its result.
+ * 2. shutdown stops accepting experiments, finishes the queued ones and
+ * stops the workers.
+ * 3. getStats and printStats report the throughput of the pool: rounds
+ * and JumpPrime queries per second per worker (one worker per core), and
+ * how busy each worker was.
+ *
+ * ASSUMPTIONS:
+ * 1. A slice runs whole steps, so one step (one counting pass over an
+ * experiment's population) is the granularity of scheduling; an experiment
+ * with a very large population holds its worker for the length of a pass.
+ * Experiments are meant to be small.
+ * 2. submit may be called from any thread. An experiment submitted after
+ * shutdown is not run; its result has completed set to false.
+ * 3. Experiments run the original configuration (DuelingJP), with the
+ * default jump value and bound.
+ */
+
+/// ExperimentSpec describes one experiment.
+struct ExperimentSpec {
+    /// The encapsulated numbers of the experiment's JumpPrime objects.
+    std::vector<int> seeds;
+
+    /// The number of counting rounds.
+    int rounds = 1;
+
+    /// The experiment's share of worker time relative to others (>= 1).
+    int priority = 1;
+};
+
+/// ExperimentResult is what one experiment counted.
+struct ExperimentResult {
+    /// false if the experiment was submitted after shutdown and not run.
+    bool completed = false;
+
+    /// Totals over every round.
+    long long upCollisions = 0;
+    long long downCollisions = 0;
+    long long inversions = 0;
+
+    /// The number of rounds run.
+    int rounds = 0;
+
+    /// The number of time slices the experiment ran in.
+    int slices = 0;
+
+    /// Worker time spent on the experiment, including building it.
+    double runSeconds = 0;
+
+    /// Time from submission to completion.
+    double elapsedSeconds = 0;
+};
+
+/// SchedulerStats is the throughput of a scheduler's worker pool.
+struct SchedulerStats {
+    int workers = 0;
+
+    long long experiments = 0;
+    long long rounds = 0;
+    long long slices = 0;
+
+    /// JumpPrime up() and down() calls made by counting passes.
+    long long queries = 0;
+
+    /// Time since the scheduler started (until shutdown, once stopped).
+    double wallSeconds = 0;
+
+    /// Time each worker spent running slices.
+    std::vector<double> workerBusySeconds;
+};
+
+/// ExperimentScheduler multiplexes DuelingJP experiments over a pool of
+/// worker threads.
+class ExperimentScheduler {
+
+    /// ExperimentTask is a submitted experiment and where it is up to.
+    struct ExperimentTask;
+
+    /// TaskOrder puts the task with the least virtual run time (then the
+    /// earliest submitted) at the top of the ready queue.
+    struct TaskOrder {
+        bool operator()(const ExperimentTask *first,
+                        const ExperimentTask *second) const;
+    };
+
+    /// WorkerStats is what one worker measured, on its own cache line.
+    struct alignas(64) WorkerStats {
+        std::atomic<long long> busyNanoseconds{0};
+    };
+
+    /// Guards readyTasks, virtualClock, nextSequence and stopping.
+    std::mutex queueMutex;
+    std::condition_variable taskReady;
+
+    std::priority_queue<ExperimentTask *, std::vector<ExperimentTask *>, TaskOrder>
+            readyTasks;
+
+    /// The virtual run time of the most recently started slice.
+    double virtualClock;
+
+    /// The submission number of the next task.
+    long long nextSequence;
+
+    /// true once shutdown has been called.
+    bool stopping;
+
+    std::vector<std::thread> workers;
+    WorkerStats *workerStats;
+    int workerCount;
+
+    /// Totals over completed slices.
+    std::atomic<long long> experimentCount;
+    std::atomic<long long> roundCount;
+    std::atomic<long long> sliceCount;
+    std::atomic<long long> queryCount;
+
+    /// When the workers started, and when the last one stopped (valid
+    /// once stopped is true).
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point stopTime;
+    std::atomic<bool> stopped;
+
+    /// The most worker time a slice may use before yielding.
+    std::chrono::nanoseconds sliceLength;
+
+    /// runWorker takes ready tasks and runs them until shutdown.
+    /// @param [in] workerNumber The worker's position in workerStats.
+    void runWorker(int workerNumber);
+
+    /// runStep runs the next step of a task.
+    /// @return true if the task has finished.
+    bool runStep(ExperimentTask &task);
+
+public:
+
+    /// The slice length used when none is given.
+    static constexpr int DEFAULT_SLICE_MICROSECONDS = 2000;
+
+    /// ExperimentScheduler Constructor starts the worker pool.
+    /// @param [in] workerThreads The number of workers; 0 for one per core.
+    /// @param [in] sliceMicroseconds The worker time an experiment runs for
+    /// before another ready experiment gets its turn.
+    explicit ExperimentScheduler(int workerThreads = 0,
+                                 int sliceMicroseconds = DEFAULT_SLICE_MICROSECONDS);
+
+    /// ExperimentScheduler Destructor finishes the queued experiments and
+    /// stops the workers.
+    ~ExperimentScheduler();
+
+    ExperimentScheduler(const ExperimentScheduler &) = delete;
+    ExperimentScheduler &operator=(const ExperimentScheduler &) = delete;
+
+    /// submit queues an experiment.
+    /// @param [in] spec The experiment to run.
+    /// @return A future that becomes ready when the experiment finishes.
+    std::future<ExperimentResult> submit(const ExperimentSpec &spec);
+
+    /// shutdown stops accepting experiments, waits until every queued
+    /// experiment has finished and stops the workers. Calling it again
+    /// does nothing.
+    void shutdown();
+
+    /// getWorkerCount returns the number of worker threads.
+    int getWorkerCount() const;
+
+    /// getStats returns the throughput of the pool so far.
+    SchedulerStats getStats() const;
+
+    /// printStats prints the pool's throughput per core and per worker.
+    /// @param [in] stats The statistics to print.
+    /// @param [in] output The stream to print to.
+    static void printStats(const SchedulerStats &stats, std::ostream &output);
+
+};
+
+
+#endif //INC_5011_P4_EXPERIMENTSCHEDULER_H
@@ -0,0 +1,78 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include "HotPathCounters.h"
+
+
+namespace HotPathCounters {
+
+PerThreadRegistry<CounterBlock> &registry() {
+    // never destroyed, so threads exiting during shutdown can still
+    // release their blocks
+    static PerThreadRegistry<CounterBlock> *counterRegistry =
+            new PerThreadRegistry<CounterBlock>;
+    return *counterRegistry;
+}
+
+CounterSnapshot snapshot() {
+    CounterSnapshot totals;
+
+    if (enabled()) {
+        registry().forEach([&totals](const CounterBlock &block) {
+            for (int i = 0; i < HOT_PATH_COUNTER_COUNT; i++) {
+                totals.values[i] += block.values[i].load(std::memory_order_relaxed);
+            }
+        });
+    }
+
+    return totals;
+}
+
+CounterSnapshot diff(const CounterSnapshot &later, const CounterSnapshot &earlier) {
+    CounterSnapshot difference;
+
+    for (int i = 0; i < HOT_PATH_COUNTER_COUNT; i++) {
+        difference.values[i] = later.values[i] - earlier.values[i];
+    }
+
+    return difference;
+}
+
+const char *counterName(HotPathCounter counter) {
+    switch (counter) {
+        case HotPathCounter::IsPrimeCalls:
+            return "isPrime calls";
+        case HotPathCounter::FindPrimeCalls:
+            return "findPrime calls";
+        case HotPathCounter::PrimeCandidates:
+            return "prime candidates examined";
+        case HotPathCounter::Divisions:
+            return "trial divisions";
+        case HotPathCounter::Jumps:
+            return "jumps";
+        case HotPathCounter::Revives:
+            return "revives";
+        case HotPathCounter::Resets:
+            return "resets";
+        case HotPathCounter::Failures:
+            return "failures";
+        case HotPathCounter::PrimeCacheHits:
+            return "prime cache hits";
+        case HotPathCounter::CollisionPasses:
+            return "collision passes";
+        case HotPathCounter::InversionPasses:
+            return "inversion passes";
+        default:
+            return "unknown";
+    }
+}
+
+void print(const CounterSnapshot &counters, std::ostream &output) {
+    for (int i = 0; i < HOT_PATH_COUNTER_COUNT; i++) {
+        output << counterName(static_cast<HotPathCounter>(i)) << ": "
+               << counters.values[i] << "\n";
+    }
+}
+
+} // namespace HotPathCounters
@@ -0,0 +1,136 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_HOTPATHCOUNTERS_H
+#define INC_5011_P4_HOTPATHCOUNTERS_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include "PerThread.h"
+
+
+/*
+ * Hot-path counters for JumpPrime and DuelingJP.
+ *
+ * The library counts its expensive steps (primality tests, candidates
+ * examined by the prime search, trial divisions, jumps, revives, resets,
+ * failures, prime cache hits and counting passes) when built with
+ * JP_ENABLE_COUNTERS (the CMake option P4_ENABLE_COUNTERS). Without it the
+ * JP_COUNT macros expand to nothing and the snapshot API reports zeros.
+ *
+ * Each thread increments its own cache-line aligned block of counters with
+ * plain relaxed loads and stores (a block only ever has one writer), so
+ * counting never contends between threads. snapshot() sums every block,
+ * including the blocks of threads that have exited, and diff() subtracts
+ * two snapshots to attribute the cost of a stretch of work.
+ *
+ * ASSUMPTIONS:
+ * 1. Counters only increase. A snapshot taken while other threads are
+ * counting is not a single instant across threads, but each counter in it
+ * is a value that counter actually held.
+ */
+
+/// HotPathCounter names the counted events.
+enum class HotPathCounter : int {
+    IsPrimeCalls,
+    FindPrimeCalls,
+    PrimeCandidates,
+    Divisions,
+    Jumps,
+    Revives,
+    Resets,
+    Failures,
+    PrimeCacheHits,
+    CollisionPasses,
+    InversionPasses,
+    Count
+};
+
+/// The number of counted events.
+const int HOT_PATH_COUNTER_COUNT = static_cast<int>(HotPathCounter::Count);
+
+/// CounterSnapshot holds the value of every counter at one point in time.
+struct CounterSnapshot {
+    std::uint64_t values[HOT_PATH_COUNTER_COUNT] = {};
+
+    /// get returns the value of one counter.
+    std::uint64_t get(HotPathCounter counter) const {
+        return values[static_cast<int>(counter)];
+    }
+};
+
+/// CounterBlock is one thread's set of counters, padded to whole cache
+/// lines so no two threads share a line.
+struct alignas(64) CounterBlock {
+    std::atomic<std::uint64_t> values[HOT_PATH_COUNTER_COUNT] = {};
+    std::atomic<bool> inUse{false};
+    CounterBlock *next = nullptr;
+};
+
+namespace HotPathCounters {
+
+/// registry returns the list of every thread's counter block.
+PerThreadRegistry<CounterBlock> &registry();
+
+/// localBlock returns the calling thread's counter block.
+inline CounterBlock *localBlock() {
+    thread_local ThreadBlockHandle<CounterBlock> handle(registry());
+    return handle.get();
+}
+
+/// add increases a counter of the calling thread.
+/// @param [in] counter The counter to increase.
+/// @param [in] amount The amount to add.
+inline void add(HotPathCounter counter, std::uint64_t amount) {
+    std::atomic<std::uint64_t> &value =
+            localBlock()->values[static_cast<int>(counter)];
+    value.store(value.load(std::memory_order_relaxed) + amount,
+                std::memory_order_relaxed);
+}
+
+/// enabled reports whether the library was built with counters.
+/// @return true if JP_ENABLE_COUNTERS was defined.
+constexpr bool enabled() {
+#ifdef JP_ENABLE_COUNTERS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// snapshot sums the counters of every thread.
+/// @return The current totals (all zero if counters are disabled).
+CounterSnapshot snapshot();
+
+/// diff subtracts an earlier snapshot from a later one.
+/// @param [in] later The later snapshot.
+/// @param [in] earlier The earlier snapshot.
+/// @return The amount each counter increased by in between.
+CounterSnapshot diff(const CounterSnapshot &later, const CounterSnapshot &earlier);
+
+/// counterName returns a printable name for a counter.
+/// @param [in] counter The counter to name.
+/// @return The counter's name.
+const char *counterName(HotPathCounter counter);
+
+/// print writes one "name: value" line per counter.
+/// @param [in] counters The snapshot to print.
+/// @param [in] output The stream to print to.
+void print(const CounterSnapshot &counters, std::ostream &output);
+
+} // namespace HotPathCounters
+
+#ifdef JP_ENABLE_COUNTERS
+#define JP_COUNT(counter) \
+    HotPathCounters::add(HotPathCounter::counter, 1)
+#define JP_COUNT_ADD(counter, amount) \
+    HotPathCounters::add(HotPathCounter::counter, (amount))
+#else
+#define JP_COUNT(counter) ((void) 0)
+#define JP_COUNT_ADD(counter, amount) ((void) 0)
+#endif
+
+
+#endif //INC_5011_P4_HOTPATHCOUNTERS_H
@@ -0,0 +1,257 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "HyperLogLog.h"
+
+
+namespace {
+
+/// sigma is the correction for empty registers in Ertl's estimator.
+double sigma(double x) {
+    if (x == 1.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    double y = 1.0;
+    double z = x;
+    double previous;
+    do {
+        x *= x;
+        previous = z;
+        z += x * y;
+        y += y;
+    } while (z != previous);
+
+    return z;
+}
+
+/// tau is the correction for saturated registers in Ertl's estimator.
+double tau(double x) {
+    if ((x == 0.0) || (x == 1.0)) {
+        return 0.0;
+    }
+
+    double y = 1.0;
+    double z = 1.0 - x;
+    double previous;
+    do {
+        x = std::sqrt(x);
+        previous = z;
+        y *= 0.5;
+        z -= (1.0 - x) * (1.0 - x) * y;
+    } while (z != previous);
+
+    return z / 3.0;
+}
+
+} // namespace
+
+
+std::size_t HyperLogLog::getRegisterCount() const {
+    return static_cast<std::size_t>(1) << precision;
+}
+
+std::size_t HyperLogLog::getExactSlots() const {
+    // the table takes as many bytes as the registers would
+    return getRegisterCount() / sizeof(std::uint64_t);
+}
+
+void HyperLogLog::insertExact(std::uint64_t hash) {
+    // 0 marks an empty slot
+    if (hash == 0) {
+        hash = 1;
+    }
+
+    std::size_t mask = getExactSlots() - 1;
+    std::size_t slot = static_cast<std::size_t>(hash) & mask;
+    while (exactHashes[slot] != 0) {
+        if (exactHashes[slot] == hash) {
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    exactHashes[slot] = hash;
+    exactCount++;
+
+    if (static_cast<std::size_t>(exactCount) * 2 > getExactSlots()) {
+        useRegisters();
+    }
+}
+
+void HyperLogLog::insertRegister(std::uint64_t hash) {
+    const int valueBits = 64 - precision;
+
+    std::size_t index = static_cast<std::size_t>(hash >> valueBits);
+    std::uint64_t remaining = hash << precision;
+
+    // the position of the first 1 bit among the remaining bits
+    std::uint8_t rank = static_cast<std::uint8_t>(
+            (remaining == 0) ? valueBits + 1 : __builtin_clzll(remaining) + 1);
+
+    if (rank > registers[index]) {
+        registers[index] = rank;
+    }
+}
+
+void HyperLogLog::useRegisters() {
+    registers = new std::uint8_t[getRegisterCount()]();
+
+    for (std::size_t i = 0; i < getExactSlots(); i++) {
+        if (exactHashes[i] != 0) {
+            insertRegister(exactHashes[i]);
+        }
+    }
+
+    delete[] exactHashes;
+    exactHashes = nullptr;
+    exactCount = 0;
+}
+
+
+HyperLogLog::HyperLogLog(int sketchPrecision) {
+    precision = std::min(std::max(sketchPrecision, MIN_PRECISION), MAX_PRECISION);
+    registers = nullptr;
+    exactHashes = new std::uint64_t[getExactSlots()]();
+    exactCount = 0;
+}
+
+HyperLogLog::~HyperLogLog() {
+    delete[] registers;
+    delete[] exactHashes;
+}
+
+HyperLogLog::HyperLogLog(const HyperLogLog &sourceObject) {
+    precision = sourceObject.precision;
+    registers = nullptr;
+    exactHashes = nullptr;
+    exactCount = sourceObject.exactCount;
+
+    if (sourceObject.registers != nullptr) {
+        registers = new std::uint8_t[getRegisterCount()];
+        std::memcpy(registers, sourceObject.registers, getRegisterCount());
+    }
+    if (sourceObject.exactHashes != nullptr) {
+        exactHashes = new std::uint64_t[getExactSlots()];
+        std::memcpy(exactHashes, sourceObject.exactHashes,
+                    getExactSlots() * sizeof(std::uint64_t));
+    }
+}
+
+HyperLogLog::HyperLogLog(HyperLogLog &&sourceObject) {
+    precision = sourceObject.precision;
+    registers = sourceObject.registers;
+    exactHashes = sourceObject.exactHashes;
+    exactCount = sourceObject.exactCount;
+
+    // clear the source
+    sourceObject.registers = nullptr;
+    sourceObject.exactHashes = nullptr;
+    sourceObject.exactCount = 0;
+}
+
+HyperLogLog &HyperLogLog::operator=(const HyperLogLog &sourceObject) {
+
+    // check to verify they're not the same object
+    if (this != &sourceObject) {
+        HyperLogLog tempObject(sourceObject);
+        *this = std::move(tempObject);
+    }
+
+    return *this;
+}
+
+HyperLogLog &HyperLogLog::operator=(HyperLogLog &&sourceObject) {
+
+    // swap contents
+    std::swap(precision, sourceObject.precision);
+    std::swap(registers, sourceObject.registers);
+    std::swap(exactHashes, sourceObject.exactHashes);
+    std::swap(exactCount, sourceObject.exactCount);
+
+    return *this;
+}
+
+void HyperLogLog::addHash(std::uint64_t hash) {
+    if (registers != nullptr) {
+        insertRegister(hash);
+    } else if (exactHashes != nullptr) {
+        insertExact(hash);
+    }
+}
+
+bool HyperLogLog::merge(const HyperLogLog &otherSketch) {
+    if (otherSketch.precision != precision) {
+        return false;
+    }
+
+    if (otherSketch.exactHashes != nullptr) {
+        // copy first in case otherSketch is this sketch
+        HyperLogLog otherCopy(otherSketch);
+        for (std::size_t i = 0; i < getExactSlots(); i++) {
+            if (otherCopy.exactHashes[i] != 0) {
+                addHash(otherCopy.exactHashes[i]);
+            }
+        }
+    } else if (otherSketch.registers != nullptr) {
+        if (registers == nullptr) {
+            useRegisters();
+        }
+        for (std::size_t i = 0; i < getRegisterCount(); i++) {
+            registers[i] = std::max(registers[i], otherSketch.registers[i]);
+        }
+    }
+
+    return true;
+}
+
+double HyperLogLog::estimate() const {
+    if (registers == nullptr) {
+        return static_cast<double>(exactCount);
+    }
+
+    const int valueBits = 64 - precision;
+
+    // how many registers hold each rank
+    int histogram[64 + 2] = {};
+    for (std::size_t i = 0; i < getRegisterCount(); i++) {
+        histogram[registers[i]]++;
+    }
+
+    double m = static_cast<double>(getRegisterCount());
+    double z = m * tau(1.0 - histogram[valueBits + 1] / m);
+    for (int k = valueBits; k >= 1; k--) {
+        z += histogram[k];
+        z *= 0.5;
+    }
+    z += m * sigma(histogram[0] / m);
+
+    // alpha_infinity * m^2 / z with alpha_infinity = 1 / (2 ln 2)
+    return m / (2.0 * std::log(2.0)) * m / z;
+}
+
+bool HyperLogLog::isExact() const {
+    return registers == nullptr;
+}
+
+void HyperLogLog::clear() {
+    delete[] registers;
+    delete[] exactHashes;
+
+    registers = nullptr;
+    exactHashes = new std::uint64_t[getExactSlots()]();
+    exactCount = 0;
+}
+
+int HyperLogLog::getPrecision() const {
+    return precision;
+}
+
+std::size_t HyperLogLog::getMemoryBytes() const {
+    return getRegisterCount();
+}
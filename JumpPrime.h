@@ -5,6 +5,10 @@
 #ifndef INC_5011_P2_JUMPPRIME_H
 #define INC_5011_P2_JUMPPRIME_H
 
+#include <cstdint>
+#include "PrimeCache.h"
+#include "Primality.h"
+
 /*
  * The JumpPrime object encapsulates a positive integer that must be at
  * least 3 digits long. The user can query the object for the two nearest
@@ -32,45 +36,141 @@
  * active state (i.e., capable of returning input).
  * 5. isDisabled() indicates whether the object has failed. A failed object
  * cannot be successfully queried nor can it be reset or revived.
+ * 6. fillUp() and fillDown() write the results of many up() or down() calls
+ * at once. Every call between two jumps returns the same prime, so each
+ * such run is written with a single fill; a RevivePolicy says what happens
+ * when the object deactivates partway. BasicOutputView (see
+ * JumpPrimeOutputView.h) iterates over the results the same way.
  *
  * OTHER ASSUMPTIONS:
  * 1. When the JumpPrime object jumps, it jumps in the direction of the last
  * query. If it jumps after an `up` call, the jump is positive in direction.
  * If it jumps after a 'down' call, the jump is negative in direction.
  * 2. When the JumpPrime object jumps, it jumps a specified magnitude past
- * the next prime. For a jump in the positive direction, it jumps to the
- * next higher prime plus the default jump value. For a jump in the negative
- * direction, it jumps to the next lower prime minus the default jump value.
- * 3. The default jump value is specified as a class constant (here, 100).
+ * the next prime: the object's own jump value. For a jump in the positive
+ * direction, it jumps to the next higher prime plus its jump value. For a
+ * jump in the negative direction, it jumps to the next lower prime minus
+ * its jump value.
+ * 3. Each object is given its jump value and jump bound when it is
+ * constructed; when they are not given, it uses the defaults of the traits
+ * class of BasicJumpPrime (JUMP_VALUE and JUMP_BOUND; 100 and 10 for
+ * DefaultJumpTraits, so JumpPrime, the default configuration, uses those).
+ * The traits class also sets the lower limit and the primality test. An
+ * object keeps its jump value and jump bound through reset(), revive(), ++
+ * and +=. The new object made by + takes the jump value and jump bound of
+ * its JumpPrime operand (the left operand when both are JumpPrime objects).
  * 4. JumpPrime objects can be added to one another. Adding one JumpPrime
  * object to another increases the encapsulated number. It also resets
  * object (because I don't want to deal with it).
  */
 
-/// The JumpPrime class encapsulates a positive integer and provides the
+/*
+ * CONFIGURATIONS:
+ * BasicJumpPrime and BasicDuelingJP take a traits class that fixes the
+ * configuration at compile time, so each configuration gets its own
+ * specialized code with the constants folded in. A traits class provides:
+ *   typedef ... Value;                           // the number type
+ *   typedef ... Primality;                       // see Primality.h
+ *   static constexpr int JUMP_VALUE;             // distance past a prime
+ *   static constexpr unsigned int JUMP_BOUND;    // jumps before deactivating
+ *   static constexpr int LOWER_LIMIT;            // smallest initial value
+ *   static constexpr Value INITIAL_VALUE;        // default initial value
+ *   static constexpr bool CHECK_OVERFLOW;        // fail instead of wrapping
+ *   typedef ... PrimeCache;                      // see PrimeCache.h
+ * The easiest way to write one is to derive from DefaultJumpTraits and
+ * override what differs. JumpPrime and DuelingJP (and the configurations
+ * below) are compiled into the library; other configurations are
+ * instantiated wherever they are used.
+ *
+ * OVERFLOW:
+ * With CHECK_OVERFLOW, any step whose exact result does not fit in Value
+ * (a jump, a prime search past the top of the range, or an addition or
+ * increment) puts the object in the failed state instead of wrapping
+ * around. Without it the arithmetic wraps as in the original JumpPrime.
+ */
+
+/// DefaultJumpTraits is the original JumpPrime configuration.
+struct DefaultJumpTraits {
+    typedef unsigned int Value;
+    typedef TrialDivisionPrimality Primality;
+    static constexpr int JUMP_VALUE = 100;
+    static constexpr unsigned int JUMP_BOUND = 10;
+    static constexpr int LOWER_LIMIT = 100;
+    static constexpr Value INITIAL_VALUE = 9999;
+    static constexpr bool CHECK_OVERFLOW = false;
+    typedef NoPrimeCache PrimeCache;
+};
+
+/// MillerRabinJumpTraits is the original configuration with a Miller-Rabin
+/// prime search. Its results are identical; only its speed differs.
+struct MillerRabinJumpTraits : DefaultJumpTraits {
+    typedef MillerRabinPrimality Primality;
+};
+
+/// JumpTraits64 is the original configuration with 64-bit numbers, a
+/// 64-bit Miller-Rabin prime search and overflow detection.
+struct JumpTraits64 : DefaultJumpTraits {
+    typedef std::uint64_t Value;
+    typedef MillerRabin64Primality Primality;
+    static constexpr Value INITIAL_VALUE = 9999;
+    static constexpr bool CHECK_OVERFLOW = true;
+};
+
+/// CachedJumpTraits is the Miller-Rabin configuration with its prime
+/// neighbourhoods shared across the process (see SharedPrimeCache), for
+/// many populations simulated side by side.
+struct CachedJumpTraits : MillerRabinJumpTraits {
+    typedef SharedPrimeCache PrimeCache;
+};
+
+/// RevivePolicy says what a bulk fill (fillUp or fillDown) does when the
+/// JumpPrime object deactivates before every value is written.
+enum class RevivePolicy {
+    /// Stop filling; the count written tells where the object deactivated.
+    Stop,
+    /// Revive the object and keep filling, as DuelingJP does before a query.
+    Revive,
+    /// Write 0 for the rest, as up() and down() return while inactive.
+    FillZero
+};
+
+/// The BasicJumpPrime class encapsulates a positive integer and provides the
 /// user information about the closest prime numbers in the positive and
 /// negative direction.
-class JumpPrime {
+template <class Traits>
+class BasicJumpPrime {
+
+public:
 
-    enum Status {
+    /// The type of the encapsulated number and of the primes.
+    typedef typename Traits::Value Value;
+
+private:
+
+    /// The benchmark suite times the private prime search directly.
+    friend class JumpPrimeBenchmark;
+
+    // The data members below are saved as-is by DuelingJPSnapshot. Changing
+    // their types or order changes the snapshot format (bump its version).
+    enum Status : int {
         Active, Inactive, Failed
     };
 
     // class constants
-    static const unsigned int DEFAULT_JUMP_BOUND = 10;
-    static const unsigned int DEFAULT_INITIAL_VALUE = 9999;
-    static const int DEFAULT_JUMP_VALUE = 100;
-    static const int LOWER_LIMIT = 100;
+    static constexpr unsigned int DEFAULT_JUMP_BOUND = Traits::JUMP_BOUND;
+    static constexpr Value DEFAULT_INITIAL_VALUE = Traits::INITIAL_VALUE;
+    static constexpr int DEFAULT_JUMP_VALUE = Traits::JUMP_VALUE;
+    static constexpr int LOWER_LIMIT = Traits::LOWER_LIMIT;
 
     /**
      * The initial value that the JumpPrime object was seeded with.
      */
-    unsigned int initialNumber;
+    Value initialNumber;
 
     /**
      * The current value of the JumpPrime object.
      */
-    unsigned int mainNumber;
+    Value mainNumber;
 
     // for tracking the object's state
     Status currentState;
@@ -81,17 +181,23 @@ class JumpPrime {
     int jumpCount;
     int jumpLimit;
 
-    unsigned int upperPrime;
-    unsigned int lowerPrime;
+    /**
+     * The distance past the next prime that the object jumps.
+     */
+    int jumpValue;
+
+    Value upperPrime;
+    Value lowerPrime;
 
     /**
      * isPrime determines whether or not the given positive integer is a prime
      * number or not (i.e., a whole number greater than one that cannot be
-     * exactly divided by any whole number other than itself)
+     * exactly divided by any whole number other than itself), using the
+     * primality backend of the traits class.
      * @param testNumber the positive integer to test
      * @return true if the number is prime, false otherwise
      */
-    bool isPrime(unsigned int testNumber);
+    static bool isPrime(Value testNumber);
 
     /**
      * findPrime finds either the next nearest prime number or the previous
@@ -103,7 +209,7 @@ class JumpPrime {
      * @return the next (or previous) positive prime integer within the bounds
      * of the unsigned integer date type
      */
-    unsigned int findPrime(unsigned int startValue, bool findNext);
+    static Value findPrime(Value startValue, bool findNext);
 
     /**
      * setPrimeLimits finds a new upper and lower prime number based on the
@@ -120,10 +226,50 @@ class JumpPrime {
     /**
      * jumpNumber "jumps" the value of the stored number, mainNumber, by a
      * specified amount. After a set number of "jumps", the JumpPrime will deactive.
-     * @param jumpValue the value (positive or negative) to "jump" the stored
-     * number by.
+     * @param jumpAmount the value (positive or negative, as a wrapped
+     * unsigned value) to "jump" the stored number by.
+     */
+    void jumpNumber(Value jumpAmount);
+
+    /**
+     * jumpOverflows reports whether a jump from a prime, plus or minus the
+     * jump value, would leave the range of Value. Always false when the
+     * configuration does not check overflow.
+     * @param primeValue the prime the jump is measured from.
+     * @param jumpOffset the signed distance past the prime.
+     * @return true if the jump cannot be represented.
+     */
+    bool jumpOverflows(Value primeValue, int jumpOffset) const;
+
+    /**
+     * sumOverflows reports whether a sum of the encapsulated number and a
+     * signed or unsigned addend leaves the range of Value. Always false
+     * when the configuration does not check overflow.
+     * @param baseValue the number added to.
+     * @param addValue the number to add.
+     * @return true if the sum cannot be represented.
+     */
+    template <class Addend>
+    static bool sumOverflows(Value baseValue, Addend addValue) {
+        Value sum;
+        return Traits::CHECK_OVERFLOW &&
+               __builtin_add_overflow(baseValue, addValue, &sum);
+    }
+
+    /**
+     * fail moves the object into the failed state.
+     */
+    void fail();
+
+    /**
+     * fillOutputs makes the bulk fills of fillUp and fillDown.
+     * @param outputs array of at least count values
+     * @param count the number of results wanted
+     * @param upward true to fill up() results, false for down() results
+     * @param policy what to do when the object deactivates
+     * @return the number of results written
      */
-    void jumpNumber(int jumpValue);
+    int fillOutputs(Value *outputs, int count, bool upward, RevivePolicy policy);
 
 public:
     /**
@@ -133,9 +279,39 @@ public:
      * @param jumpBound the number of times that the object with jump before
      * becoming inactive. If none is specified, the defined default value
      * will be used.
+     * @param jumpSize the distance past the next prime that the object
+     * jumps. If none is specified, the defined default value will be used.
+     */
+    BasicJumpPrime(Value initValue = DEFAULT_INITIAL_VALUE,
+                   unsigned int jumpBound = DEFAULT_JUMP_BOUND,
+                   int jumpSize = DEFAULT_JUMP_VALUE);
+
+    /**
+     * isPrimeNumber tests a number with the configuration's primality
+     * backend, without constructing a JumpPrime object.
+     * @param testNumber the number to test
+     * @return true if the number is prime (0 and 1 are reported prime, as
+     * by every backend)
      */
-    JumpPrime(unsigned int initValue = DEFAULT_INITIAL_VALUE,
-              unsigned int jumpBound = DEFAULT_JUMP_BOUND);
+    static bool isPrimeNumber(Value testNumber);
+
+    /**
+     * nextPrime finds the nearest prime above a number with the same search
+     * that sets a JumpPrime object's upper prime.
+     * @param startValue the number to search up from
+     * @return the smallest prime greater than startValue; the search wraps
+     * past the top of the range of Value
+     */
+    static Value nextPrime(Value startValue);
+
+    /**
+     * previousPrime finds the nearest prime below a number with the same
+     * search that sets a JumpPrime object's lower prime.
+     * @param startValue the number to search down from
+     * @return the greatest prime less than startValue (1 for startValue 2,
+     * since 1 is reported prime)
+     */
+    static Value previousPrime(Value startValue);
 
     /**
      * Compares two JumpPrime objects. Two JumpPrime objects
@@ -143,7 +319,7 @@ public:
      * @param jumpCompare the JumpPrime object to compare to.
      * @return true if equal, false otherwise
      */
-    bool operator==(JumpPrime const& jumpCompare) const;
+    bool operator==(BasicJumpPrime const& jumpCompare) const;
 
     /**
      * Compares two JumpPrime objects. Two JumpPrime objects
@@ -151,7 +327,7 @@ public:
      * @param jumpCompare the JumpPrime object to compare to.
      * @return true if not equal, false otherwise
      */
-    bool operator!=(const JumpPrime &jumpCompare) const;
+    bool operator!=(const BasicJumpPrime &jumpCompare) const;
 
 
     /**
@@ -160,7 +336,7 @@ public:
      * @param jumpCompare the JumpPrime object to compare to.
      * @return true if LHS is greater, false otherwise
      */
-    bool operator>(const JumpPrime &jumpCompare) const;
+    bool operator>(const BasicJumpPrime &jumpCompare) const;
 
     /**
      * Compares two JumpPrime objects. A JumpPrime object is greater
@@ -169,7 +345,7 @@ public:
      * @param jumpCompare the JumpPrime object to compare to.
      * @return true if LHS is greater than or equal, false otherwise
      */
-    bool operator>=(const JumpPrime &jumpCompare) const;
+    bool operator>=(const BasicJumpPrime &jumpCompare) const;
 
     /**
      * Compares two JumpPrime objects. A JumpPrime object is less
@@ -177,7 +353,7 @@ public:
      * @param jumpCompare the JumpPrime object to compare to.
      * @return true if LHS is lesser, false otherwise
      */
-    bool operator<(const JumpPrime &jumpCompare) const;
+    bool operator<(const BasicJumpPrime &jumpCompare) const;
 
     /**
      * Compares two JumpPrime objects. A JumpPrime object is less
@@ -186,7 +362,7 @@ public:
      * @param jumpCompare the JumpPrime object to compare to.
      * @return true if LHS is less than or equal, false otherwise
      */
-    bool operator<=(const JumpPrime &jumpCompare) const;
+    bool operator<=(const BasicJumpPrime &jumpCompare) const;
 
     /**
      * operator+ adds an integer to the JumpPrime object. This
@@ -196,7 +372,7 @@ public:
      * @return a new JumpPrime object that encapsulates the sum of the
      * encapsulated number and the integer.
      */
-    JumpPrime operator+(int addNumber) const;
+    BasicJumpPrime operator+(int addNumber) const;
 
     /**
      * opreator+ adds a JumpPrime object to the JumpPrime object. This
@@ -208,14 +384,14 @@ public:
      * @return a new JumpPrime object that encapsulates the sum of the
      * encapsulated numbers.
      */
-    JumpPrime operator+(JumpPrime const& jumpAdd) const;
+    BasicJumpPrime operator+(BasicJumpPrime const& jumpAdd) const;
 
     /**
      * The prefix increment operator increments the encapsulated number
      * in the JumpPrime object and resets it.
      * @return the JumpPrime object after the increment.
      */
-    JumpPrime operator++();
+    BasicJumpPrime operator++();
 
     /**
      * The prefix increment operator increments the encapsulated number
@@ -223,7 +399,7 @@ public:
      * object prior to the incrementation.
      * @return the JumpPrime object prior to the increment.
      */
-    const JumpPrime operator++(int);
+    const BasicJumpPrime operator++(int);
 
 
     /**
@@ -237,7 +413,17 @@ public:
      * @return a JumpPrime object that encapsulates the sum of the integer and
      * the encapsulated JumpPrime.
      */
-    friend JumpPrime operator+(int addNumber, JumpPrime const& jumpAdd);
+    friend BasicJumpPrime operator+(int addNumber, BasicJumpPrime const& jumpAdd) {
+        Value newValue = jumpAdd.mainNumber + addNumber;
+
+        BasicJumpPrime newJP(newValue, jumpAdd.getJumpBound(),
+                             jumpAdd.jumpValue);
+        if (sumOverflows(jumpAdd.mainNumber, addNumber)) {
+            newJP.fail();
+        }
+
+        return newJP;
+    }
 
     /**
      * operator+= adds an integer to the JumpPrime object and adds it to
@@ -247,7 +433,7 @@ public:
      * @param addNumber the number to add to the JumpPrime object
      * @return the JumpPrime object, reset, with stuff added
      */
-    JumpPrime& operator+=(int addNumber);
+    BasicJumpPrime& operator+=(int addNumber);
 
     /**
      * operator+= adds a the encapsulated number of the given JumpPrime object
@@ -257,7 +443,7 @@ public:
      * @param jumpAdd the JumpPrime object to add to this
      * @return the JumpPrime object, reset, with stuff added
      */
-    JumpPrime& operator+=(JumpPrime const& jumpAdd);
+    BasicJumpPrime& operator+=(BasicJumpPrime const& jumpAdd);
 
 
     /**
@@ -268,7 +454,7 @@ public:
      * @return the next highest prime number. If the JumpPrime object has been
      * deactivated, returns 0.
      */
-    unsigned int up();
+    Value up();
 
     /**
      * down returns the next lowest prime number from the number stored in the
@@ -279,7 +465,31 @@ public:
      * deactivated, returns 0.
      * @return
      */
-    unsigned int down();
+    Value down();
+
+    /**
+     * fillUp writes the results of count consecutive up() calls, leaving the
+     * object as those calls would. Each run of results between two jumps
+     * is written with one fill instead of a call per value.
+     * @param outputs array of at least count values
+     * @param count the number of results wanted
+     * @param policy what to do if the object deactivates (see RevivePolicy)
+     * @return the number of results written. Less than count only if the
+     * object deactivated under RevivePolicy::Stop or could not be revived.
+     */
+    int fillUp(Value *outputs, int count, RevivePolicy policy = RevivePolicy::Stop);
+
+    /**
+     * fillDown writes the results of count consecutive down() calls, leaving
+     * the object as those calls would. Each run of results between two
+     * jumps is written with one fill instead of a call per value.
+     * @param outputs array of at least count values
+     * @param count the number of results wanted
+     * @param policy what to do if the object deactivates (see RevivePolicy)
+     * @return the number of results written. Less than count only if the
+     * object deactivated under RevivePolicy::Stop or could not be revived.
+     */
+    int fillDown(Value *outputs, int count, RevivePolicy policy = RevivePolicy::Stop);
 
     /**
      * Reset attempts to reset the JumpPrime object to the original integer
@@ -322,10 +532,48 @@ public:
      * set value. After a jump, this is the new jumped-to value.
      * @return the current value encapsulated by the JumpPrime object.
      */
-    unsigned int getCurrentValue() const;
+    Value getCurrentValue() const;
+
+    /**
+     * getJumpValue returns the distance past the next prime that the
+     * object jumps.
+     * @return the jump value given at construction.
+     */
+    int getJumpValue() const;
+
+    /**
+     * getJumpBound returns the number of times that the object jumps
+     * before becoming inactive.
+     * @return the jump bound given at construction.
+     */
+    unsigned int getJumpBound() const;
+
+    /**
+     * hasSameState compares the complete state of two JumpPrime objects
+     * (initial and current number, prime limits, counters, limits, jump
+     * value and status). Two JumpPrime objects with the same state return the same
+     * sequence of results from any sequence of calls.
+     * @param jumpCompare the JumpPrime object to compare to.
+     * @return true if every part of the state is equal, false otherwise
+     */
+    bool hasSameState(const BasicJumpPrime &jumpCompare) const;
 
 
 };
 
+/// JumpPrime is the original configuration.
+typedef BasicJumpPrime<DefaultJumpTraits> JumpPrime;
+
+/// JumpPrime64 is the 64-bit configuration.
+typedef BasicJumpPrime<JumpTraits64> JumpPrime64;
+
+
+#include "JumpPrimeImpl.h"
+
+// the library compiles these configurations once (JumpPrime.cpp)
+extern template class BasicJumpPrime<DefaultJumpTraits>;
+extern template class BasicJumpPrime<MillerRabinJumpTraits>;
+extern template class BasicJumpPrime<JumpTraits64>;
+extern template class BasicJumpPrime<CachedJumpTraits>;
 
 #endif //INC_5011_P2_JUMPPRIME_H
@@ -0,0 +1,484 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_JUMPPRIMEIMPL_H
+#define INC_5011_P4_JUMPPRIMEIMPL_H
+
+#include <algorithm>
+#include <limits>
+#include "JumpPrime.h"
+#include "HotPathCounters.h"
+#include "LatencyHistogram.h"
+#include "TraceEvents.h"
+
+// Member definitions of BasicJumpPrime, included at the end of JumpPrime.h.
+
+
+template <class Traits>
+bool BasicJumpPrime<Traits>::isPrime(Value testNumber) {
+    JP_COUNT(IsPrimeCalls);
+
+    return Traits::Primality::isPrime(testNumber);
+}
+
+template <class Traits>
+typename BasicJumpPrime<Traits>::Value
+BasicJumpPrime<Traits>::findPrime(Value startValue, bool findNext) {
+    // determine if this needs to count up or down
+    int stepValue = findNext ? 1 : -1;
+
+    Value result = startValue + stepValue;
+    unsigned int candidates = 1;
+
+    while (!isPrime(result)) {
+        result = result + stepValue;
+        candidates++;
+    }
+
+    JP_COUNT(FindPrimeCalls);
+    JP_COUNT_ADD(PrimeCandidates, candidates);
+    (void) candidates;
+
+    return result;
+}
+
+template <class Traits>
+bool BasicJumpPrime<Traits>::isPrimeNumber(Value testNumber) {
+    return isPrime(testNumber);
+}
+
+template <class Traits>
+typename BasicJumpPrime<Traits>::Value
+BasicJumpPrime<Traits>::nextPrime(Value startValue) {
+    return findPrime(startValue, true);
+}
+
+template <class Traits>
+typename BasicJumpPrime<Traits>::Value
+BasicJumpPrime<Traits>::previousPrime(Value startValue) {
+    return findPrime(startValue, false);
+}
+
+template <class Traits>
+void BasicJumpPrime<Traits>::setPrimeLimits() {
+    JP_LATENCY_SCOPE(SetPrimeLimits);
+
+    if (Traits::PrimeCache::find(mainNumber, lowerPrime, upperPrime)) {
+        JP_COUNT(PrimeCacheHits);
+        return;
+    }
+
+    upperPrime = findPrime(mainNumber, true);
+    lowerPrime = findPrime(mainNumber, false);
+
+    // the upward search wrapped past the top of the range
+    if (Traits::CHECK_OVERFLOW && (upperPrime <= mainNumber)) {
+        fail();
+    }
+
+    // only neighbourhoods that did not wrap around are shared
+    if (Traits::PrimeCache::ENABLED &&
+        (lowerPrime < mainNumber) && (mainNumber < upperPrime)) {
+        Traits::PrimeCache::store(lowerPrime, mainNumber, upperPrime,
+                                  isPrime(mainNumber));
+    }
+
+}
+
+template <class Traits>
+void BasicJumpPrime<Traits>::resetQueryCounter() {
+    queryLimit = upperPrime - lowerPrime;
+    queryCount = 0;
+}
+
+template <class Traits>
+void BasicJumpPrime<Traits>::jumpNumber(Value jumpAmount) {
+    JP_LATENCY_SCOPE(JumpNumber);
+    JP_TRACE_SCOPE(Jump, mainNumber + jumpAmount);
+
+    // initiate the jump
+    mainNumber = mainNumber + jumpAmount;
+
+    setPrimeLimits();
+    resetQueryCounter();
+
+    jumpCount++;
+    JP_COUNT(Jumps);
+
+    if (Traits::CHECK_OVERFLOW && (currentState == Failed)) {
+        return;
+    }
+
+    // test to see if JumpPrime object has reached the jump limit
+    if (jumpCount >= jumpLimit) {
+        // turn off the object
+        currentState = Inactive;
+
+    }
+}
+
+template <class Traits>
+bool BasicJumpPrime<Traits>::jumpOverflows(Value primeValue,
+                                           int jumpOffset) const {
+    if (!Traits::CHECK_OVERFLOW) {
+        return false;
+    }
+
+    static_assert(sizeof(Value) <= 8, "overflow checks need a wider type");
+    __int128 target = static_cast<__int128>(mainNumber) + primeValue + jumpOffset;
+    return (target < 0) ||
+           (target > static_cast<__int128>(std::numeric_limits<Value>::max()));
+}
+
+template <class Traits>
+void BasicJumpPrime<Traits>::fail() {
+    if (currentState != Failed) {
+        currentState = Failed;
+        JP_COUNT(Failures);
+    }
+}
+
+template <class Traits>
+BasicJumpPrime<Traits>::BasicJumpPrime(Value initValue,
+                                       unsigned int jumpBound,
+                                       int jumpSize) {
+    JP_TRACE_SCOPE(Construct, initValue);
+
+    jumpValue = jumpSize;
+
+    // less than four digits
+    if (initValue < LOWER_LIMIT) {
+        currentState = Failed;
+        JP_COUNT(Failures);
+
+        // the object is unusable, but its state is still well-defined
+        initialNumber = initValue;
+        mainNumber = initValue;
+        jumpLimit = jumpBound;
+        jumpCount = 0;
+        queryCount = 0;
+        queryLimit = 0;
+        upperPrime = 0;
+        lowerPrime = 0;
+    }
+    // otherwise, proceed with initialization
+    else {
+        currentState = Active;
+        jumpLimit = jumpBound;
+        initialNumber = initValue;
+        this->reset();
+    }
+}
+
+template <class Traits>
+bool BasicJumpPrime<Traits>::operator==(const BasicJumpPrime &jumpCompare) const {
+    if (this->mainNumber == jumpCompare.mainNumber) {
+        return true;
+    } else {
+        return false;
+    }
+}
+
+template <class Traits>
+bool BasicJumpPrime<Traits>::operator!=(const BasicJumpPrime &jumpCompare) const {
+    return !(*this == jumpCompare);
+}
+
+template <class Traits>
+bool BasicJumpPrime<Traits>::operator>(const BasicJumpPrime &jumpCompare) const {
+    return (this->mainNumber > jumpCompare.mainNumber);
+}
+
+template <class Traits>
+bool BasicJumpPrime<Traits>::operator>=(const BasicJumpPrime &jumpCompare) const {
+    return (this->mainNumber >= jumpCompare.mainNumber);
+}
+
+template <class Traits>
+bool BasicJumpPrime<Traits>::operator<(const BasicJumpPrime &jumpCompare) const {
+    return (this->mainNumber < jumpCompare.mainNumber);
+}
+
+template <class Traits>
+bool BasicJumpPrime<Traits>::operator<=(const BasicJumpPrime &jumpCompare) const {
+    return (this->mainNumber <= jumpCompare.mainNumber);
+}
+
+template <class Traits>
+BasicJumpPrime<Traits> BasicJumpPrime<Traits>::operator+(int addNumber) const {
+    Value tempValue;
+
+    tempValue = this->mainNumber + addNumber;
+
+    BasicJumpPrime returnJump(tempValue, getJumpBound(), jumpValue);
+    if (sumOverflows(this->mainNumber, addNumber)) {
+        returnJump.fail();
+    }
+
+    return returnJump;
+}
+
+template <class Traits>
+BasicJumpPrime<Traits> BasicJumpPrime<Traits>::operator+(const BasicJumpPrime &jumpAdd) const {
+
+    Value tempValue;
+
+    tempValue = this->mainNumber + jumpAdd.mainNumber;
+
+    BasicJumpPrime returnJump(tempValue, getJumpBound(), jumpValue);
+    if (sumOverflows(this->mainNumber, jumpAdd.mainNumber)) {
+        returnJump.fail();
+    }
+
+    return returnJump;
+}
+
+template <class Traits>
+BasicJumpPrime<Traits> BasicJumpPrime<Traits>::operator++() {
+
+    this->initialNumber = this->mainNumber + 1;
+    if (sumOverflows(this->mainNumber, 1) ||
+        (this->initialNumber < LOWER_LIMIT)) {
+        this->currentState = Failed;
+        JP_COUNT(Failures);
+    } else {
+        this->currentState = Active;
+        this->reset();
+    }
+    return *this;
+}
+
+template <class Traits>
+const BasicJumpPrime<Traits> BasicJumpPrime<Traits>::operator++(int dummy) {
+    BasicJumpPrime const tempJP = *this;
+    this->initialNumber = this->mainNumber + 1;
+    if (sumOverflows(this->mainNumber, 1) ||
+        (this->initialNumber < LOWER_LIMIT)) {
+        this->currentState = Failed;
+        JP_COUNT(Failures);
+    } else {
+        this->currentState = Active;
+        this->reset();
+    }
+    return tempJP;
+}
+
+template <class Traits>
+BasicJumpPrime<Traits>& BasicJumpPrime<Traits>::operator+=(int addNumber) {
+    this->initialNumber = this->mainNumber + addNumber;
+    if (sumOverflows(this->mainNumber, addNumber) ||
+        (this->initialNumber < LOWER_LIMIT)) {
+        this->currentState = Failed;
+        JP_COUNT(Failures);
+    } else {
+        this->currentState = Active;
+        this->reset();
+    }
+    return *this;
+}
+
+template <class Traits>
+BasicJumpPrime<Traits>& BasicJumpPrime<Traits>::operator+=(const BasicJumpPrime &jumpAdd) {
+
+    this->initialNumber = this->mainNumber + jumpAdd.mainNumber;
+    if (sumOverflows(this->mainNumber, jumpAdd.mainNumber) ||
+        (this->initialNumber < LOWER_LIMIT)) {
+        this->currentState = Failed;
+        JP_COUNT(Failures);
+    } else {
+        this->currentState = Active;
+        this->reset();
+    }
+
+    return *this;
+}
+
+template <class Traits>
+typename BasicJumpPrime<Traits>::Value BasicJumpPrime<Traits>::up() {
+    JP_LATENCY_SCOPE(Up);
+
+    if (currentState == Active) {
+        // storing the upper prime in the case that the object jumps
+        // after this query
+        Value returnValue = upperPrime;
+
+        queryCount++;
+
+        if (queryCount >= queryLimit) {
+            if (jumpOverflows(upperPrime, jumpValue)) {
+                fail();
+            } else {
+                jumpNumber(upperPrime + jumpValue);
+            }
+
+        }
+
+        return returnValue;
+    }
+    return 0;
+}
+
+
+template <class Traits>
+typename BasicJumpPrime<Traits>::Value BasicJumpPrime<Traits>::down() {
+    JP_LATENCY_SCOPE(Down);
+
+    if (currentState == Active) {
+        // storing the upper prime in the case that the object jumps
+        // after this query
+        Value returnValue = lowerPrime;
+
+        queryCount++;
+
+        if (queryCount >= queryLimit) {
+            if (jumpOverflows(lowerPrime, -jumpValue)) {
+                fail();
+            } else {
+                jumpNumber(lowerPrime - jumpValue);
+            }
+        }
+
+        return returnValue;
+    }
+    return 0;
+}
+
+
+
+template <class Traits>
+int BasicJumpPrime<Traits>::fillOutputs(Value *outputs, int count, bool upward,
+                                        RevivePolicy policy) {
+    int filled = 0;
+
+    while (filled < count) {
+        if (currentState != Active) {
+            if ((policy == RevivePolicy::Revive) &&
+                (currentState == Inactive) && revive()) {
+                continue;
+            }
+            if (policy == RevivePolicy::FillZero) {
+                std::fill_n(outputs + filled, count - filled, Value(0));
+                filled = count;
+            }
+            break;
+        }
+
+        // every query until the next jump returns the same prime
+        Value prime = upward ? upperPrime : lowerPrime;
+        int run = std::min(std::max(queryLimit - queryCount, 1), count - filled);
+        std::fill_n(outputs + filled, run, prime);
+        filled += run;
+        queryCount += run;
+
+        if (queryCount >= queryLimit) {
+            int jumpOffset = upward ? jumpValue : -jumpValue;
+            if (jumpOverflows(prime, jumpOffset)) {
+                fail();
+            } else {
+                jumpNumber(prime + jumpOffset);
+            }
+        }
+    }
+
+    return filled;
+}
+
+template <class Traits>
+int BasicJumpPrime<Traits>::fillUp(Value *outputs, int count, RevivePolicy policy) {
+    return fillOutputs(outputs, count, true, policy);
+}
+
+template <class Traits>
+int BasicJumpPrime<Traits>::fillDown(Value *outputs, int count, RevivePolicy policy) {
+    return fillOutputs(outputs, count, false, policy);
+}
+
+template <class Traits>
+bool BasicJumpPrime<Traits>::reset() {
+    if (currentState == Failed) {
+        return false;
+    }
+
+    else {
+        JP_COUNT(Resets);
+        JP_TRACE_SCOPE(Reset, initialNumber);
+        currentState = Active;
+        mainNumber = initialNumber;
+
+        setPrimeLimits();
+        resetQueryCounter();
+
+        jumpCount = 0;
+
+        // a checked configuration fails if the prime search overflows
+        return (currentState == Active);
+    }
+}
+
+
+template <class Traits>
+bool BasicJumpPrime<Traits>::revive() {
+    JP_COUNT(Revives);
+
+    // object is not running and is not permanently broken
+    if (currentState == Inactive) {
+        // revive the object
+        currentState = Active;
+        jumpCount = 0;
+        queryCount = 0;
+    }
+    // in any other case
+    else {
+        // revive permanently disables the object
+        currentState = Failed;
+        JP_COUNT(Failures);
+    }
+
+    return (currentState == Active);
+}
+
+
+template <class Traits>
+bool BasicJumpPrime<Traits>::isActive() {
+    return (currentState == Active);
+}
+
+
+template <class Traits>
+bool BasicJumpPrime<Traits>::isDisabled() {
+    return (currentState == Failed);
+}
+
+template <class Traits>
+typename BasicJumpPrime<Traits>::Value
+BasicJumpPrime<Traits>::getCurrentValue() const {
+    return mainNumber;
+}
+
+template <class Traits>
+int BasicJumpPrime<Traits>::getJumpValue() const {
+    return jumpValue;
+}
+
+template <class Traits>
+unsigned int BasicJumpPrime<Traits>::getJumpBound() const {
+    return static_cast<unsigned int>(jumpLimit);
+}
+
+template <class Traits>
+bool BasicJumpPrime<Traits>::hasSameState(const BasicJumpPrime &jumpCompare) const {
+    return (currentState == jumpCompare.currentState) &&
+           (initialNumber == jumpCompare.initialNumber) &&
+           (mainNumber == jumpCompare.mainNumber) &&
+           (upperPrime == jumpCompare.upperPrime) &&
+           (lowerPrime == jumpCompare.lowerPrime) &&
+           (queryCount == jumpCompare.queryCount) &&
+           (queryLimit == jumpCompare.queryLimit) &&
+           (jumpCount == jumpCompare.jumpCount) &&
+           (jumpLimit == jumpCompare.jumpLimit) &&
+           (jumpValue == jumpCompare.jumpValue);
+}
+
+
+#endif //INC_5011_P4_JUMPPRIMEIMPL_H
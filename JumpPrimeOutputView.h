@@ -0,0 +1,194 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_JUMPPRIMEOUTPUTVIEW_H
+#define INC_5011_P4_JUMPPRIMEOUTPUTVIEW_H
+
+#include <cstddef>
+#include <iterator>
+#include "JumpPrime.h"
+
+
+/*
+ * BasicOutputView is a range over the results of a JumpPrime object's up()
+ * or down() calls, for consumers that read long sequences of them:
+ *
+ *     for (unsigned int prime : outputsUp(jumper, 1000000)) { ... }
+ *
+ * The view fills a buffer of results with fillUp() or fillDown() and the
+ * iterator walks the buffer, so the JumpPrime object is called once per
+ * BUFFER_SIZE results (and each run between two jumps is one fill) rather
+ * than once per result.
+ *
+ * ASSUMPTIONS:
+ * 1. The view is an input range: it can be iterated once, and advancing
+ * one of its iterators advances them all.
+ * 2. The view refers to its JumpPrime object, which must outlive it and
+ * must not be used while the view is being iterated. The object is
+ * queried ahead of the iteration by up to BUFFER_SIZE results; when the
+ * view ends, exactly the results it produced have been queried.
+ * 3. The view holds its buffer, so it cannot be copied or moved; keep it
+ * where outputsUp or outputsDown created it.
+ */
+
+/// BasicOutputView iterates over the results of a JumpPrime object's
+/// up() or down() calls.
+template <class Traits>
+class BasicOutputView {
+
+public:
+
+    /// The type of the results.
+    typedef typename BasicJumpPrime<Traits>::Value Value;
+
+    /// The number of results filled at a time.
+    static constexpr int BUFFER_SIZE = 1024;
+
+private:
+
+    /// The JumpPrime object queried.
+    BasicJumpPrime<Traits> *source;
+
+    /// true for up() results, false for down() results.
+    bool upward;
+
+    /// What a fill does when the object deactivates.
+    RevivePolicy policy;
+
+    /// The number of results not yet filled.
+    long long remaining;
+
+    /// The filled results, read from bufferPosition to bufferCount.
+    Value buffer[BUFFER_SIZE];
+    int bufferCount;
+    int bufferPosition;
+
+    /// refill fills the buffer with the next results.
+    /// @return false if there are no more results.
+    bool refill() {
+        bufferPosition = 0;
+        bufferCount = 0;
+        if (remaining <= 0) {
+            return false;
+        }
+
+        int wanted = (remaining < BUFFER_SIZE) ? static_cast<int>(remaining)
+                                               : BUFFER_SIZE;
+        bufferCount = upward ? source->fillUp(buffer, wanted, policy)
+                             : source->fillDown(buffer, wanted, policy);
+
+        // a short fill means the object stopped producing
+        remaining = (bufferCount < wanted) ? 0 : remaining - bufferCount;
+        return (bufferCount > 0);
+    }
+
+    /// advance moves to the next result.
+    /// @return false if there are no more results.
+    bool advance() {
+        bufferPosition++;
+        return (bufferPosition < bufferCount) || refill();
+    }
+
+public:
+
+    /// iterator reads the results of a view in order.
+    class iterator {
+
+        /// The view read from, or nullptr past the last result.
+        BasicOutputView *view;
+
+    public:
+
+        typedef std::input_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Value *pointer;
+        typedef const Value &reference;
+
+        explicit iterator(BasicOutputView *iterated = nullptr) : view(iterated) {}
+
+        reference operator*() const {
+            return view->buffer[view->bufferPosition];
+        }
+
+        iterator &operator++() {
+            if (!view->advance()) {
+                view = nullptr;
+            }
+            return *this;
+        }
+
+        bool operator==(const iterator &compareIterator) const {
+            return view == compareIterator.view;
+        }
+
+        bool operator!=(const iterator &compareIterator) const {
+            return view != compareIterator.view;
+        }
+
+    };
+
+    /// BasicOutputView Constructor creates a view of a JumpPrime object's
+    /// results. Nothing is queried until the view is iterated.
+    /// @param [in] jumper The JumpPrime object to query.
+    /// @param [in] fillUpward true for up() results, false for down().
+    /// @param [in] count The number of results to produce.
+    /// @param [in] revivePolicy What to do when the object deactivates.
+    BasicOutputView(BasicJumpPrime<Traits> &jumper, bool fillUpward,
+                    long long count, RevivePolicy revivePolicy) {
+        source = &jumper;
+        upward = fillUpward;
+        policy = revivePolicy;
+        remaining = count;
+        bufferCount = 0;
+        bufferPosition = 0;
+    }
+
+    BasicOutputView(const BasicOutputView &) = delete;
+    BasicOutputView &operator=(const BasicOutputView &) = delete;
+
+    /// begin returns an iterator at the first result not yet read.
+    iterator begin() {
+        if ((bufferPosition < bufferCount) || refill()) {
+            return iterator(this);
+        }
+        return end();
+    }
+
+    /// end returns the iterator past the last result.
+    iterator end() {
+        return iterator();
+    }
+
+};
+
+/// outputsUp makes a view of the results of count up() calls.
+/// @param [in] jumper The JumpPrime object to query.
+/// @param [in] count The number of results.
+/// @param [in] policy What to do when the object deactivates; by default
+/// it is revived, so the view produces count results unless it fails.
+/// @return The view.
+template <class Traits>
+BasicOutputView<Traits> outputsUp(BasicJumpPrime<Traits> &jumper, long long count,
+                                  RevivePolicy policy = RevivePolicy::Revive) {
+    return BasicOutputView<Traits>(jumper, true, count, policy);
+}
+
+/// outputsDown makes a view of the results of count down() calls.
+/// @param [in] jumper The JumpPrime object to query.
+/// @param [in] count The number of results.
+/// @param [in] policy What to do when the object deactivates; by default
+/// it is revived, so the view produces count results unless it fails.
+/// @return The view.
+template <class Traits>
+BasicOutputView<Traits> outputsDown(BasicJumpPrime<Traits> &jumper, long long count,
+                                    RevivePolicy policy = RevivePolicy::Revive) {
+    return BasicOutputView<Traits>(jumper, false, count, policy);
+}
+
+/// OutputView is the view of the original configuration.
+typedef BasicOutputView<DefaultJumpTraits> OutputView;
+
+
+#endif //INC_5011_P4_JUMPPRIMEOUTPUTVIEW_H
@@ -0,0 +1,139 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <cmath>
+#include "LatencyHistogram.h"
+
+
+LatencyHistogram::LatencyHistogram() : buckets(), totalCount(0) {
+}
+
+std::uint64_t LatencyHistogram::bucketLowerBound(int index) {
+    const int subBuckets = 1 << LATENCY_SUB_BUCKET_BITS;
+    if (index < subBuckets) {
+        return static_cast<std::uint64_t>(index);
+    }
+
+    int shift = (index >> LATENCY_SUB_BUCKET_BITS) - 1;
+    std::uint64_t subBucket = static_cast<std::uint64_t>(index & (subBuckets - 1));
+    return (static_cast<std::uint64_t>(subBuckets) + subBucket) << shift;
+}
+
+void LatencyHistogram::add(int index, std::uint64_t count) {
+    buckets[index] += count;
+    totalCount += count;
+}
+
+std::uint64_t LatencyHistogram::getCount() const {
+    return totalCount;
+}
+
+std::uint64_t LatencyHistogram::percentile(double fraction) const {
+    if (totalCount == 0) {
+        return 0;
+    }
+
+    // the rank of the wanted duration, counting from one
+    std::uint64_t rank = static_cast<std::uint64_t>(
+            std::ceil(fraction * static_cast<double>(totalCount)));
+    if (rank < 1) {
+        rank = 1;
+    }
+
+    std::uint64_t seen = 0;
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return bucketLowerBound(i);
+        }
+    }
+
+    return maximum();
+}
+
+std::uint64_t LatencyHistogram::maximum() const {
+    for (int i = LATENCY_BUCKET_COUNT - 1; i >= 0; i--) {
+        if (buckets[i] > 0) {
+            return bucketLowerBound(i);
+        }
+    }
+
+    return 0;
+}
+
+void LatencyHistogram::exportBuckets(std::ostream &output) const {
+    output << "lower_ns,count\n";
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        if (buckets[i] > 0) {
+            output << bucketLowerBound(i) << "," << buckets[i] << "\n";
+        }
+    }
+}
+
+
+namespace LatencyHistograms {
+
+PerThreadRegistry<HistogramBlock> &registry() {
+    // never destroyed, so threads exiting during shutdown can still
+    // release their blocks
+    static PerThreadRegistry<HistogramBlock> *histogramRegistry =
+            new PerThreadRegistry<HistogramBlock>;
+    return *histogramRegistry;
+}
+
+LatencyHistogram aggregate(LatencySite site) {
+    LatencyHistogram histogram;
+    int siteIndex = static_cast<int>(site);
+
+    if (enabled()) {
+        registry().forEach([&histogram, siteIndex](const HistogramBlock &block) {
+            for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+                std::uint64_t count =
+                        block.buckets[siteIndex][i].load(std::memory_order_relaxed);
+                if (count > 0) {
+                    histogram.add(i, count);
+                }
+            }
+        });
+    }
+
+    return histogram;
+}
+
+const char *siteName(LatencySite site) {
+    switch (site) {
+        case LatencySite::Up:
+            return "up";
+        case LatencySite::Down:
+            return "down";
+        case LatencySite::JumpNumber:
+            return "jumpNumber";
+        case LatencySite::SetPrimeLimits:
+            return "setPrimeLimits";
+        case LatencySite::CollisionPass:
+            return "collisionPass";
+        case LatencySite::InversionPass:
+            return "inversionPass";
+        default:
+            return "unknown";
+    }
+}
+
+void exportSummary(std::ostream &output) {
+    output << "site,count,p50_ns,p90_ns,p99_ns,p999_ns,max_ns\n";
+    for (int i = 0; i < LATENCY_SITE_COUNT; i++) {
+        LatencySite site = static_cast<LatencySite>(i);
+        LatencyHistogram histogram = aggregate(site);
+
+        output << siteName(site) << ","
+               << histogram.getCount() << ","
+               << histogram.percentile(0.50) << ","
+               << histogram.percentile(0.90) << ","
+               << histogram.percentile(0.99) << ","
+               << histogram.percentile(0.999) << ","
+               << histogram.maximum() << "\n";
+    }
+}
+
+} // namespace LatencyHistograms
@@ -0,0 +1,197 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_LATENCYHISTOGRAM_H
+#define INC_5011_P4_LATENCYHISTOGRAM_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include "PerThread.h"
+
+
+/*
+ * Latency histograms for JumpPrime and DuelingJP.
+ *
+ * When the library is built with JP_ENABLE_HISTOGRAMS (the CMake option
+ * P4_ENABLE_HISTOGRAMS), the duration of every up(), down(), jumpNumber(),
+ * setPrimeLimits() and DuelingJP counting pass is recorded in a
+ * log-bucketed histogram for its site. Without it the JP_LATENCY_SCOPE
+ * macro expands to nothing and the query API reports empty histograms.
+ *
+ * BUCKETS (HDR-style):
+ * Durations are in nanoseconds. Values below 2^SUB_BUCKET_BITS get a bucket
+ * each; above that, every power of two is split into 2^SUB_BUCKET_BITS
+ * equal sub-buckets. With SUB_BUCKET_BITS = 5 every recorded value is within
+ * about 3% of its bucket's lower bound, from 1 ns up to about 2^63 ns.
+ *
+ * Recording is lock-free: each thread increments its own buckets (one
+ * writer per block, relaxed stores), and queries sum the buckets of every
+ * thread, including threads that have exited.
+ */
+
+/// LatencySite names the timed operations.
+enum class LatencySite : int {
+    Up,
+    Down,
+    JumpNumber,
+    SetPrimeLimits,
+    CollisionPass,
+    InversionPass,
+    Count
+};
+
+/// The number of timed operations.
+const int LATENCY_SITE_COUNT = static_cast<int>(LatencySite::Count);
+
+/// The number of sub-buckets per power of two is 2^SUB_BUCKET_BITS.
+const int LATENCY_SUB_BUCKET_BITS = 5;
+
+/// The number of buckets in one histogram.
+const int LATENCY_BUCKET_COUNT =
+        (64 - LATENCY_SUB_BUCKET_BITS + 1) << LATENCY_SUB_BUCKET_BITS;
+
+/// LatencyHistogram is an aggregated histogram of one site.
+class LatencyHistogram {
+
+    std::uint64_t buckets[LATENCY_BUCKET_COUNT];
+    std::uint64_t totalCount;
+
+public:
+
+    LatencyHistogram();
+
+    /// bucketIndex returns the bucket a duration is counted in.
+    /// @param [in] nanoseconds The duration.
+    /// @return The bucket number.
+    static int bucketIndex(std::uint64_t nanoseconds) {
+        const std::uint64_t subBuckets = 1ull << LATENCY_SUB_BUCKET_BITS;
+        if (nanoseconds < subBuckets) {
+            return static_cast<int>(nanoseconds);
+        }
+
+        int topBit = 63 - __builtin_clzll(nanoseconds);
+        int shift = topBit - LATENCY_SUB_BUCKET_BITS;
+        int subBucket = static_cast<int>(nanoseconds >> shift) -
+                        static_cast<int>(subBuckets);
+        return ((shift + 1) << LATENCY_SUB_BUCKET_BITS) + subBucket;
+    }
+
+    /// bucketLowerBound returns the smallest duration counted in a bucket.
+    /// @param [in] index The bucket number.
+    /// @return The lower bound in nanoseconds.
+    static std::uint64_t bucketLowerBound(int index);
+
+    /// add counts durations into a bucket.
+    /// @param [in] index The bucket number.
+    /// @param [in] count The number of durations to add.
+    void add(int index, std::uint64_t count);
+
+    /// getCount returns the number of recorded durations.
+    /// @return The total count.
+    std::uint64_t getCount() const;
+
+    /// percentile returns the lower bound of the bucket holding the given
+    /// fraction of recorded durations.
+    /// @param [in] fraction The percentile as a fraction (0.99 for p99).
+    /// @return The duration in nanoseconds, or 0 if nothing was recorded.
+    std::uint64_t percentile(double fraction) const;
+
+    /// maximum returns the lower bound of the highest non-empty bucket.
+    /// @return The duration in nanoseconds, or 0 if nothing was recorded.
+    std::uint64_t maximum() const;
+
+    /// exportBuckets writes every non-empty bucket as "lower_ns,count" CSV
+    /// lines.
+    /// @param [in] output The stream to write to.
+    void exportBuckets(std::ostream &output) const;
+
+};
+
+/// HistogramBlock is one thread's buckets for every site.
+struct alignas(64) HistogramBlock {
+    std::atomic<std::uint64_t> buckets[LATENCY_SITE_COUNT][LATENCY_BUCKET_COUNT] = {};
+    std::atomic<bool> inUse{false};
+    HistogramBlock *next = nullptr;
+};
+
+namespace LatencyHistograms {
+
+/// registry returns the list of every thread's histogram block.
+PerThreadRegistry<HistogramBlock> &registry();
+
+/// localBlock returns the calling thread's histogram block.
+inline HistogramBlock *localBlock() {
+    thread_local ThreadBlockHandle<HistogramBlock> handle(registry());
+    return handle.get();
+}
+
+/// record counts one duration for a site in the calling thread's buckets.
+/// @param [in] site The timed operation.
+/// @param [in] nanoseconds The duration.
+inline void record(LatencySite site, std::uint64_t nanoseconds) {
+    std::atomic<std::uint64_t> &bucket =
+            localBlock()->buckets[static_cast<int>(site)]
+                                 [LatencyHistogram::bucketIndex(nanoseconds)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_relaxed);
+}
+
+/// enabled reports whether the library was built with histograms.
+/// @return true if JP_ENABLE_HISTOGRAMS was defined.
+constexpr bool enabled() {
+#ifdef JP_ENABLE_HISTOGRAMS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// aggregate sums the buckets of every thread for one site.
+/// @param [in] site The timed operation.
+/// @return The site's histogram (empty if histograms are disabled).
+LatencyHistogram aggregate(LatencySite site);
+
+/// siteName returns a printable name for a site.
+/// @param [in] site The timed operation.
+/// @return The site's name.
+const char *siteName(LatencySite site);
+
+/// exportSummary writes one CSV line per site with its count and its
+/// p50, p90, p99, p999 and maximum in nanoseconds.
+/// @param [in] output The stream to write to.
+void exportSummary(std::ostream &output);
+
+/// LatencyScope records the time from its construction to its
+/// destruction for one site.
+class LatencyScope {
+    LatencySite site;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit LatencyScope(LatencySite timedSite)
+            : site(timedSite), start(std::chrono::steady_clock::now()) {}
+
+    ~LatencyScope() {
+        std::chrono::nanoseconds elapsed =
+                std::chrono::steady_clock::now() - start;
+        record(site, static_cast<std::uint64_t>(elapsed.count()));
+    }
+
+    LatencyScope(const LatencyScope &) = delete;
+    LatencyScope &operator=(const LatencyScope &) = delete;
+};
+
+} // namespace LatencyHistograms
+
+#ifdef JP_ENABLE_HISTOGRAMS
+#define JP_LATENCY_SCOPE(site) \
+    LatencyHistograms::LatencyScope jpLatencyScope(LatencySite::site)
+#else
+#define JP_LATENCY_SCOPE(site) ((void) 0)
+#endif
+
+
+#endif //INC_5011_P4_LATENCYHISTOGRAM_H
@@ -0,0 +1,429 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "DuelingJP.h"
+#include "HotPathCounters.h"
+#include "LatencyHistogram.h"
+#include "TelemetrySink.h"
+#include "TraceEvents.h"
+#include "WorkerPool.h"
+#include "LoadGenerator.h"
+
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/// The number of primes seeds cluster around in the clustered distribution.
+const int CLUSTER_CENTERS = 64;
+
+/// The largest distance of a clustered seed from its prime.
+const int CLUSTER_SPREAD = 3;
+
+/// The number of distinct seeds in the duplicate distribution.
+const int DUPLICATE_POOL = 16;
+
+/// LoadOperation is one kind of DuelingJP operation in the mix.
+enum LoadOperation {
+    UpCollisions, DownCollisions, Inversions
+};
+
+/// ThreadRound is what one worker thread measured in one round.
+struct ThreadRound {
+    std::vector<double> latencies;
+    long long queries = 0;
+};
+
+/// RoundSummary is what all worker threads measured in one round.
+struct RoundSummary {
+    long long operations = 0;
+    long long queries = 0;
+    double seconds = 0.0;
+};
+
+bool isSmallPrime(unsigned int testNumber) {
+    if (testNumber < 2) {
+        return false;
+    }
+    for (unsigned int i = 2; i * i <= testNumber; i++) {
+        if (testNumber % i == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// runThreadRound runs one round of operations on a thread's DuelingJP,
+/// logging each to telemetry if it is not nullptr.
+void runThreadRound(const LoadConfig &config, DuelingJP &threadDJP,
+                    std::mt19937 &generator, ThreadRound &measured,
+                    TelemetrySink *telemetry, int threadNumber, int round) {
+    std::discrete_distribution<int> mixDistribution(
+            {static_cast<double>(config.upWeight),
+             static_cast<double>(config.downWeight),
+             static_cast<double>(config.inversionWeight)});
+
+    measured.latencies.clear();
+    measured.queries = 0;
+
+    for (int op = 0; op < config.opsPerRound; op++) {
+        LoadOperation operation = static_cast<LoadOperation>(
+                mixDistribution(generator));
+
+        Clock::time_point start = Clock::now();
+        int count = 0;
+        switch (operation) {
+            case UpCollisions:
+                count = threadDJP.countCollisions(true);
+                measured.queries += threadDJP.getSize();
+                break;
+            case DownCollisions:
+                count = threadDJP.countCollisions(false);
+                measured.queries += threadDJP.getSize();
+                break;
+            case Inversions:
+                count = threadDJP.countInversions();
+                measured.queries += 2LL * threadDJP.getSize();
+                break;
+        }
+        Clock::duration elapsed = Clock::now() - start;
+        std::chrono::duration<double, std::micro> latency = elapsed;
+
+        measured.latencies.push_back(latency.count());
+
+        if (telemetry != nullptr) {
+            // LoadOperation and TelemetryOperation list the same operations
+            telemetry->record(static_cast<std::uint32_t>(threadNumber),
+                              static_cast<std::uint32_t>(round),
+                              static_cast<TelemetryOperation>(operation), count,
+                              static_cast<std::uint64_t>(
+                                      std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              elapsed).count()));
+        }
+    }
+}
+
+/// percentile returns the nearest-rank percentile of sorted samples.
+double percentile(const std::vector<double> &sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    std::size_t rank = static_cast<std::size_t>(
+            fraction * static_cast<double>(sorted.size()));
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+void printRound(std::ostream &output, const std::string &label,
+                const RoundSummary &summary, std::vector<double> &latencies) {
+    std::sort(latencies.begin(), latencies.end());
+
+    double seconds = (summary.seconds > 0.0) ? summary.seconds : 1e-9;
+    output << label
+           << "  ops=" << summary.operations
+           << "  ops/s=" << static_cast<double>(summary.operations) / seconds
+           << "  queries/s=" << static_cast<double>(summary.queries) / seconds
+           << "  p50=" << percentile(latencies, 0.50) << "us"
+           << "  p90=" << percentile(latencies, 0.90) << "us"
+           << "  p99=" << percentile(latencies, 0.99) << "us"
+           << "  max=" << (latencies.empty() ? 0.0 : latencies.back()) << "us"
+           << "\n";
+}
+
+bool parseMix(const char *mixText, LoadConfig &config) {
+    int weights[3];
+    const char *position = mixText;
+    for (int w = 0; w < 3; w++) {
+        char *end;
+        long weight = std::strtol(position, &end, 10);
+        if ((end == position) || (weight < 0) ||
+            ((w < 2) && (*end != ':')) || ((w == 2) && (*end != '\0'))) {
+            return false;
+        }
+        weights[w] = static_cast<int>(weight);
+        position = end + 1;
+    }
+
+    if (weights[0] + weights[1] + weights[2] == 0) {
+        return false;
+    }
+    config.upWeight = weights[0];
+    config.downWeight = weights[1];
+    config.inversionWeight = weights[2];
+    return true;
+}
+
+} // namespace
+
+
+void generateLoadSeeds(const LoadConfig &config, int *seeds) {
+    std::mt19937 generator(config.randomSeed);
+    std::uniform_int_distribution<unsigned int> rangeDistribution(
+            config.minSeed, config.maxSeed);
+
+    if (config.distribution == LoadDistribution::Uniform) {
+        for (int i = 0; i < config.population; i++) {
+            seeds[i] = static_cast<int>(rangeDistribution(generator));
+        }
+    }
+
+    else if (config.distribution == LoadDistribution::Clustered) {
+        // find the next prime after random points of the range
+        unsigned int centers[CLUSTER_CENTERS];
+        for (int c = 0; c < CLUSTER_CENTERS; c++) {
+            unsigned int candidate = rangeDistribution(generator);
+            while (!isSmallPrime(candidate)) {
+                candidate++;
+            }
+            centers[c] = candidate;
+        }
+
+        std::uniform_int_distribution<int> centerDistribution(0, CLUSTER_CENTERS - 1);
+        std::uniform_int_distribution<int> offsetDistribution(-CLUSTER_SPREAD,
+                                                              CLUSTER_SPREAD);
+        for (int i = 0; i < config.population; i++) {
+            long long seed = static_cast<long long>(
+                    centers[centerDistribution(generator)]) +
+                             offsetDistribution(generator);
+            // the next prime after a center near maxSeed can lie above it
+            seeds[i] = static_cast<int>(
+                    std::min<long long>(std::max<long long>(seed, config.minSeed),
+                                        config.maxSeed));
+        }
+    }
+
+    else {
+        unsigned int pool[DUPLICATE_POOL];
+        for (int p = 0; p < DUPLICATE_POOL; p++) {
+            pool[p] = rangeDistribution(generator);
+        }
+
+        std::uniform_int_distribution<int> poolDistribution(0, DUPLICATE_POOL - 1);
+        for (int i = 0; i < config.population; i++) {
+            seeds[i] = static_cast<int>(pool[poolDistribution(generator)]);
+        }
+    }
+}
+
+bool parseLoadDistribution(const char *name, LoadDistribution &distribution) {
+    if (std::strcmp(name, "uniform") == 0) {
+        distribution = LoadDistribution::Uniform;
+    } else if (std::strcmp(name, "clustered") == 0) {
+        distribution = LoadDistribution::Clustered;
+    } else if (std::strcmp(name, "duplicate") == 0) {
+        distribution = LoadDistribution::Duplicate;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char *loadDistributionName(LoadDistribution distribution) {
+    switch (distribution) {
+        case LoadDistribution::Uniform:
+            return "uniform";
+        case LoadDistribution::Clustered:
+            return "clustered";
+        case LoadDistribution::Duplicate:
+            return "duplicate";
+    }
+    return "unknown";
+}
+
+bool parseLoadConfig(int argc, char *argv[], LoadConfig &config) {
+    for (int i = 0; i < argc; i++) {
+        std::string option = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char *value = argv[++i];
+
+        if (option == "--population") {
+            config.population = std::atoi(value);
+        } else if (option == "--distribution") {
+            if (!parseLoadDistribution(value, config.distribution)) {
+                return false;
+            }
+        } else if (option == "--rounds") {
+            config.rounds = std::atoi(value);
+        } else if (option == "--ops") {
+            config.opsPerRound = std::atoi(value);
+        } else if (option == "--mix") {
+            if (!parseMix(value, config)) {
+                return false;
+            }
+        } else if (option == "--threads") {
+            config.threads = std::atoi(value);
+        } else if (option == "--min-seed") {
+            config.minSeed = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+        } else if (option == "--max-seed") {
+            config.maxSeed = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+        } else if (option == "--seed") {
+            config.randomSeed = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+        } else if (option == "--trace") {
+            config.tracePath = value;
+        } else if (option == "--telemetry") {
+            config.telemetryPath = value;
+        } else if (option == "--cpus") {
+            if (!WorkerPool::parseCpuList(value, config.cpus)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    // every thread needs at least one JumpPrime object, and every seed
+    // must be a valid JumpPrime initial value
+    return (config.threads >= 1) && (config.population >= config.threads) &&
+           (config.rounds >= 1) && (config.opsPerRound >= 1) &&
+           (config.minSeed >= 100) && (config.minSeed <= config.maxSeed) &&
+           (config.maxSeed <= 0x7fffffffu);
+}
+
+void runLoadGenerator(const LoadConfig &config, std::ostream &output) {
+    Clock::time_point setupStart = Clock::now();
+
+    int *seeds = new int[config.population];
+    generateLoadSeeds(config, seeds);
+
+    // each worker owns an even share of the population for every round,
+    // built (and so first touched) by that worker
+    WorkerPool pool(config.threads, config.cpus);
+    std::vector<DuelingJP *> threadDJPs(config.threads, nullptr);
+    pool.run([&](int t) {
+        int sliceStart = static_cast<int>(
+                static_cast<long long>(config.population) * t / config.threads);
+        int sliceEnd = static_cast<int>(
+                static_cast<long long>(config.population) * (t + 1) / config.threads);
+        threadDJPs[t] = new DuelingJP(seeds + sliceStart, sliceEnd - sliceStart);
+    });
+    delete[] seeds;
+
+    std::chrono::duration<double> setupTime = Clock::now() - setupStart;
+    output << "Load generator: population " << config.population
+           << ", threads " << config.threads
+           << ", rounds " << config.rounds
+           << ", ops/round/thread " << config.opsPerRound
+           << ", mix " << config.upWeight << ":" << config.downWeight
+           << ":" << config.inversionWeight << "\n";
+    output << "Setup seconds: " << setupTime.count() << "\n";
+    if (!config.cpus.empty()) {
+        output << "Pinned " << pool.getPinnedCount() << " of " << config.threads
+               << " threads:";
+        for (int t = 0; t < config.threads; t++) {
+            output << " " << pool.getWorkerCpu(t);
+        }
+        output << "\n";
+    }
+
+    std::vector<std::mt19937> generators;
+    for (int t = 0; t < config.threads; t++) {
+        generators.emplace_back(config.randomSeed + 1 + t);
+    }
+
+    std::vector<ThreadRound> measured(config.threads);
+    std::vector<double> allLatencies;
+    RoundSummary total;
+    CounterSnapshot countersBefore = HotPathCounters::snapshot();
+
+    TelemetrySink telemetry;
+    TelemetrySink *roundTelemetry = nullptr;
+    if (!config.telemetryPath.empty()) {
+        const std::string csvSuffix = ".csv";
+        const std::string &path = config.telemetryPath;
+        bool csv = (path.size() >= csvSuffix.size()) &&
+                   (path.compare(path.size() - csvSuffix.size(), csvSuffix.size(),
+                                 csvSuffix) == 0);
+        if (telemetry.open(path, csv ? TelemetryFormat::Csv : TelemetryFormat::Binary)) {
+            roundTelemetry = &telemetry;
+        } else {
+            output << "Could not open telemetry file " << path << "\n";
+        }
+    }
+
+    for (int round = 0; round < config.rounds; round++) {
+        Clock::time_point roundStart = Clock::now();
+
+        pool.run([&](int t) {
+            runThreadRound(config, *threadDJPs[t], generators[t], measured[t],
+                           roundTelemetry, t, round);
+        });
+
+        std::chrono::duration<double> roundTime = Clock::now() - roundStart;
+
+        RoundSummary summary;
+        summary.seconds = roundTime.count();
+        std::vector<double> roundLatencies;
+        for (const ThreadRound &threadRound : measured) {
+            summary.operations += static_cast<long long>(threadRound.latencies.size());
+            summary.queries += threadRound.queries;
+            roundLatencies.insert(roundLatencies.end(),
+                                  threadRound.latencies.begin(),
+                                  threadRound.latencies.end());
+        }
+
+        total.operations += summary.operations;
+        total.queries += summary.queries;
+        total.seconds += summary.seconds;
+        allLatencies.insert(allLatencies.end(), roundLatencies.begin(),
+                            roundLatencies.end());
+
+        printRound(output, "Round " + std::to_string(round + 1), summary,
+                   roundLatencies);
+    }
+
+    printRound(output, "Total", total, allLatencies);
+
+    pool.run([&](int t) {
+        delete threadDJPs[t];
+    });
+
+    if (roundTelemetry != nullptr) {
+        bool written = telemetry.close();
+        output << "Telemetry: " << telemetry.getWrittenCount() << " records "
+               << (written ? "written to " : "not fully written to ")
+               << config.telemetryPath << " (" << telemetry.getDroppedCount()
+               << " dropped)\n";
+    }
+
+    if (HotPathCounters::enabled()) {
+        output << "Hot-path counters over all rounds:\n";
+        HotPathCounters::print(
+                HotPathCounters::diff(HotPathCounters::snapshot(), countersBefore),
+                output);
+    }
+
+    if (LatencyHistograms::enabled()) {
+        output << "Latency histograms (cumulative):\n";
+        LatencyHistograms::exportSummary(output);
+    }
+
+    if (!config.tracePath.empty()) {
+        if (!TraceEvents::enabled()) {
+            output << "Tracing is not built in (configure with P4_ENABLE_TRACING)\n";
+        } else if (TraceEvents::writeChromeTrace(config.tracePath)) {
+            output << "Trace written to " << config.tracePath
+                   << " (" << TraceEvents::droppedSpans()
+                   << " spans dropped from full buffers)\n";
+        } else {
+            output << "Could not write trace to " << config.tracePath << "\n";
+        }
+    }
+}
+
+void printLoadUsage(std::ostream &output) {
+    output << "usage: 5011_p4 --load [--population <n>]"
+              " [--distribution uniform|clustered|duplicate]"
+              " [--rounds <n>] [--ops <n>] [--mix <up:down:inversions>]"
+              " [--threads <n>] [--min-seed <n>] [--max-seed <n>]"
+              " [--seed <n>] [--trace <file>] [--telemetry <file>]"
+              " [--cpus <list>]\n";
+}
@@ -0,0 +1,118 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_LOADGENERATOR_H
+#define INC_5011_P4_LOADGENERATOR_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+/*
+ * The load generator drives JumpPrime and DuelingJP objects with
+ * production-shaped load instead of the scripted demonstration.
+ *
+ * A population of seeds is drawn from one of three distributions and split
+ * evenly across the worker threads; each thread owns one DuelingJP object
+ * built from its share. Every round, each thread runs a fixed number of
+ * operations, choosing countCollisions (up), countCollisions (down) or
+ * countInversions at random according to the configured mix, and times
+ * every operation. After each round the throughput and the latency
+ * percentiles of that round are printed, followed by a summary over all
+ * rounds (and the hot-path counters and latency histograms, when the
+ * library records them). With --trace, the spans of the run are written
+ * as a Chrome trace-event file when the library traces. With --telemetry,
+ * the result and latency of every operation are logged through a
+ * TelemetrySink (see TelemetrySink.h), so logging never blocks the worker
+ * threads; a file name ending in .csv is written as CSV, anything else in
+ * the binary format.
+ *
+ * The worker threads are a WorkerPool (see WorkerPool.h): the same thread
+ * runs the same share of the population in every round, and builds that
+ * share itself so its memory is first touched where it is used. With
+ * --cpus, the workers are pinned to the listed CPUs.
+ *
+ * DISTRIBUTIONS:
+ * 1. uniform: seeds drawn uniformly from [minSeed, maxSeed].
+ * 2. clustered: seeds within a few integers of a small set of primes in
+ * [minSeed, maxSeed], so many JumpPrime objects share prime limits.
+ * 3. duplicate: seeds drawn from a small pool of distinct values, so many
+ * JumpPrime objects are identical.
+ *
+ * OPTIONS (after --load):
+ *   --population <n>    total number of JumpPrime objects (default 10000)
+ *   --distribution <d>  uniform | clustered | duplicate (default uniform)
+ *   --rounds <n>        number of rounds (default 10)
+ *   --ops <n>           operations per thread per round (default 10)
+ *   --mix <u:d:i>       relative weights of up collisions, down collisions
+ *                       and inversions (default 1:1:1)
+ *   --threads <n>       worker threads (default 1)
+ *   --min-seed <n>      smallest seed (default 1000)
+ *   --max-seed <n>      largest seed (default 100000)
+ *   --seed <n>          random seed for reproducible runs (default 5011)
+ *   --trace <file>      write the trace-event spans of the run to file
+ *   --telemetry <file>  log every operation's result to file
+ *   --cpus <list>       pin the threads to these CPUs, e.g. 0-3,8 (default:
+ *                       not pinned)
+ */
+
+/// LoadDistribution is the shape of the generated seed population.
+enum class LoadDistribution {
+    Uniform, Clustered, Duplicate
+};
+
+/// LoadConfig holds the settings of a load generator run.
+struct LoadConfig {
+    int population = 10000;
+    LoadDistribution distribution = LoadDistribution::Uniform;
+    int rounds = 10;
+    int opsPerRound = 10;
+    int upWeight = 1;
+    int downWeight = 1;
+    int inversionWeight = 1;
+    int threads = 1;
+    unsigned int minSeed = 1000;
+    unsigned int maxSeed = 100000;
+    unsigned int randomSeed = 5011;
+    std::string tracePath;
+    std::string telemetryPath;
+    std::vector<int> cpus;
+};
+
+/// parseLoadConfig reads load generator options.
+/// @param [in] argc The number of arguments in argv.
+/// @param [in] argv The options, not including --load itself.
+/// @param [out] config The parsed settings.
+/// @return true if every option was understood and valid.
+bool parseLoadConfig(int argc, char *argv[], LoadConfig &config);
+
+/// generateLoadSeeds draws a seed population.
+/// @param [in] config The population size, distribution, seed range and
+/// random seed to draw with.
+/// @param [out] seeds Array of config.population seeds.
+void generateLoadSeeds(const LoadConfig &config, int *seeds);
+
+/// parseLoadDistribution reads a distribution name.
+/// @param [in] name uniform, clustered or duplicate.
+/// @param [out] distribution The named distribution.
+/// @return true if the name was understood.
+bool parseLoadDistribution(const char *name, LoadDistribution &distribution);
+
+/// loadDistributionName names a distribution as parseLoadDistribution reads it.
+/// @param [in] distribution The distribution to name.
+/// @return The name.
+const char *loadDistributionName(LoadDistribution distribution);
+
+/// runLoadGenerator runs the configured load and reports each round.
+/// @param [in] config The settings of the run.
+/// @param [in] output The stream to report to.
+void runLoadGenerator(const LoadConfig &config, std::ostream &output);
+
+/// printLoadUsage describes the load generator options.
+/// @param [in] output The stream to print to.
+void printLoadUsage(std::ostream &output);
+
+
+#endif //INC_5011_P4_LOADGENERATOR_H
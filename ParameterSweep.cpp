@@ -0,0 +1,318 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "DuelingJP.h"
+#include "ParameterSweep.h"
+
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/// The largest number of grid points a sweep may have.
+const long long MAX_POINTS = 1000000;
+
+/// SweepPopulation is the seeds of one distribution and random seed.
+struct SweepPopulation {
+    LoadDistribution distribution;
+    unsigned int randomSeed;
+    std::vector<int> seeds;
+};
+
+/// parseNumberList reads comma-separated numbers and start:stop[:step]
+/// ranges, appending them to values.
+/// @return false if the list is malformed or a value is out of range.
+template <class Number>
+bool parseNumberList(const char *listText, long long minValue,
+                     long long maxValue, std::vector<Number> &values) {
+    values.clear();
+    const char *position = listText;
+
+    while (true) {
+        long long range[3] = {0, 0, 1};
+        int fieldCount = 0;
+        while (fieldCount < 3) {
+            char *end;
+            range[fieldCount] = std::strtoll(position, &end, 10);
+            if (end == position) {
+                return false;
+            }
+            fieldCount++;
+            position = end;
+            if (*position != ':') {
+                break;
+            }
+            position++;
+        }
+
+        if (fieldCount == 1) {
+            range[1] = range[0];
+        }
+        if ((range[2] <= 0) || (range[1] < range[0]) ||
+            (range[0] < minValue) || (range[1] > maxValue)) {
+            return false;
+        }
+        for (long long value = range[0]; value <= range[1]; value += range[2]) {
+            if (static_cast<long long>(values.size()) >= MAX_POINTS) {
+                return false;
+            }
+            values.push_back(static_cast<Number>(value));
+        }
+
+        if (*position == '\0') {
+            return true;
+        }
+        if (*position != ',') {
+            return false;
+        }
+        position++;
+    }
+}
+
+/// parseDistributionList reads comma-separated distribution names.
+bool parseDistributionList(const char *listText,
+                           std::vector<LoadDistribution> &distributions) {
+    distributions.clear();
+    std::string names = listText;
+    std::size_t start = 0;
+
+    while (true) {
+        std::size_t comma = names.find(',', start);
+        std::string name = names.substr(start, comma - start);
+        LoadDistribution distribution;
+        if (!parseLoadDistribution(name.c_str(), distribution)) {
+            return false;
+        }
+        distributions.push_back(distribution);
+
+        if (comma == std::string::npos) {
+            return true;
+        }
+        start = comma + 1;
+    }
+}
+
+/// simulatePoint runs the rounds of one grid point.
+template <class Traits>
+void simulatePoint(const SweepConfig &config, const SweepPopulation &population,
+                   SweepResult &result) {
+    Clock::time_point start = Clock::now();
+
+    BasicDuelingJP<Traits> pointDJP(population.seeds.data(), config.population,
+                                    static_cast<unsigned int>(result.jumpBound),
+                                    result.jumpValue);
+
+    result.upCollisions = 0;
+    result.downCollisions = 0;
+    result.inversions = 0;
+    for (int round = 0; round < config.rounds; round++) {
+        result.upCollisions += pointDJP.countCollisions(true);
+        result.downCollisions += pointDJP.countCollisions(false);
+        result.inversions += pointDJP.countInversions();
+    }
+
+    std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+    result.milliseconds = elapsed.count();
+}
+
+/// runSweepWorker simulates grid points until none are left.
+void runSweepWorker(const SweepConfig &config,
+                    const std::vector<SweepPopulation> &populations,
+                    std::atomic<long long> &nextPoint,
+                    std::vector<SweepResult> &results) {
+    long long pointsPerPopulation = static_cast<long long>(config.jumpBounds.size()) *
+                                    static_cast<long long>(config.jumpValues.size());
+
+    while (true) {
+        long long point = nextPoint.fetch_add(1, std::memory_order_relaxed);
+        if (point >= static_cast<long long>(results.size())) {
+            return;
+        }
+
+        const SweepPopulation &population = populations[point / pointsPerPopulation];
+        if (config.sharePrimes) {
+            simulatePoint<CachedJumpTraits>(config, population, results[point]);
+        } else {
+            simulatePoint<MillerRabinJumpTraits>(config, population, results[point]);
+        }
+    }
+}
+
+} // namespace
+
+
+bool parseSweepConfig(int argc, char *argv[], SweepConfig &config) {
+    for (int i = 0; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--no-share") {
+            config.sharePrimes = false;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char *value = argv[++i];
+
+        bool optionOk = true;
+        if (option == "--jump-values") {
+            optionOk = parseNumberList(value, 1, 0x7fffffff, config.jumpValues);
+        } else if (option == "--jump-bounds") {
+            optionOk = parseNumberList(value, 1, 0x7fffffff, config.jumpBounds);
+        } else if (option == "--seeds") {
+            optionOk = parseNumberList(value, 0, 0xffffffffLL, config.randomSeeds);
+        } else if (option == "--distributions") {
+            optionOk = parseDistributionList(value, config.distributions);
+        } else if (option == "--population") {
+            config.population = std::atoi(value);
+        } else if (option == "--rounds") {
+            config.rounds = std::atoi(value);
+        } else if (option == "--min-seed") {
+            config.minSeed = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+        } else if (option == "--max-seed") {
+            config.maxSeed = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+        } else if (option == "--threads") {
+            config.threads = std::atoi(value);
+        } else if (option == "--output") {
+            config.outputPath = value;
+        } else {
+            optionOk = false;
+        }
+
+        if (!optionOk) {
+            return false;
+        }
+    }
+
+    long long pointCount = static_cast<long long>(config.distributions.size()) *
+                           static_cast<long long>(config.randomSeeds.size()) *
+                           static_cast<long long>(config.jumpBounds.size()) *
+                           static_cast<long long>(config.jumpValues.size());
+
+    // every seed must be a valid JumpPrime initial value
+    return (pointCount >= 1) && (pointCount <= MAX_POINTS) &&
+           (config.population >= 1) && (config.rounds >= 1) &&
+           (config.threads >= 0) &&
+           (config.minSeed >= 100) && (config.minSeed <= config.maxSeed) &&
+           (config.maxSeed <= 0x7fffffffu);
+}
+
+double runSweep(const SweepConfig &config, std::vector<SweepResult> &results) {
+    Clock::time_point start = Clock::now();
+
+    // each population is drawn once and shared by every point that uses it
+    std::vector<SweepPopulation> populations;
+    for (LoadDistribution distribution : config.distributions) {
+        for (unsigned int randomSeed : config.randomSeeds) {
+            LoadConfig loadConfig;
+            loadConfig.population = config.population;
+            loadConfig.distribution = distribution;
+            loadConfig.minSeed = config.minSeed;
+            loadConfig.maxSeed = config.maxSeed;
+            loadConfig.randomSeed = randomSeed;
+
+            populations.push_back({distribution, randomSeed,
+                                   std::vector<int>(config.population)});
+            generateLoadSeeds(loadConfig, populations.back().seeds.data());
+        }
+    }
+
+    results.clear();
+    for (const SweepPopulation &population : populations) {
+        for (int jumpBound : config.jumpBounds) {
+            for (int jumpValue : config.jumpValues) {
+                results.push_back({population.distribution, population.randomSeed,
+                                   jumpBound, jumpValue, 0, 0, 0, 0.0});
+            }
+        }
+    }
+
+    int threadCount = config.threads;
+    if (threadCount == 0) {
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    threadCount = static_cast<int>(std::min<long long>(
+            threadCount, static_cast<long long>(results.size())));
+
+    std::atomic<long long> nextPoint{0};
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threadCount; t++) {
+        workers.emplace_back(runSweepWorker, std::cref(config), std::cref(populations),
+                             std::ref(nextPoint), std::ref(results));
+    }
+    runSweepWorker(config, populations, nextPoint, results);
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+void writeSweepTable(const std::vector<SweepResult> &results, std::ostream &output) {
+    output << "distribution\tseed\tjump_bound\tjump_value"
+              "\tup_collisions\tdown_collisions\tinversions\tmilliseconds\n";
+
+    for (const SweepResult &result : results) {
+        output << loadDistributionName(result.distribution)
+               << "\t" << result.randomSeed
+               << "\t" << result.jumpBound
+               << "\t" << result.jumpValue
+               << "\t" << result.upCollisions
+               << "\t" << result.downCollisions
+               << "\t" << result.inversions
+               << "\t" << result.milliseconds << "\n";
+    }
+}
+
+bool runParameterSweep(const SweepConfig &config, std::ostream &output) {
+    std::vector<SweepResult> results;
+    double seconds = runSweep(config, results);
+
+    bool tableOk = true;
+    if (config.outputPath.empty()) {
+        writeSweepTable(results, output);
+    } else {
+        std::ofstream tableFile(config.outputPath);
+        writeSweepTable(results, tableFile);
+        tableFile.close();
+        tableOk = !tableFile.fail();
+    }
+
+    double pointMilliseconds = 0.0;
+    for (const SweepResult &result : results) {
+        pointMilliseconds += result.milliseconds;
+    }
+
+    output << "# " << results.size() << " points, population " << config.population
+           << ", rounds " << config.rounds
+           << ", primes " << (config.sharePrimes ? "shared" : "not shared") << "\n";
+    output << "# wall seconds " << seconds
+           << ", points/s " << static_cast<double>(results.size()) / seconds
+           << ", busy threads " << pointMilliseconds / 1000.0 / seconds << "\n";
+    if (!config.outputPath.empty()) {
+        output << (tableOk ? "# table written to " : "# could not write table to ")
+               << config.outputPath << "\n";
+    }
+
+    return tableOk;
+}
+
+void printSweepUsage(std::ostream &output) {
+    output << "usage: 5011_p4 --sweep [--jump-values <list>] [--jump-bounds <list>]"
+              " [--seeds <list>]"
+              " [--distributions uniform,clustered,duplicate]"
+              " [--population <n>] [--rounds <n>] [--min-seed <n>]"
+              " [--max-seed <n>] [--threads <n>] [--no-share]"
+              " [--output <file>]\n"
+              "a list is comma-separated numbers or start:stop[:step] ranges\n";
+}
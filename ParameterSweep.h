@@ -0,0 +1,115 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_PARAMETERSWEEP_H
+#define INC_5011_P4_PARAMETERSWEEP_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "LoadGenerator.h"
+
+
+/*
+ * The parameter sweep simulates DuelingJP populations over a grid of jump
+ * values, jump bounds and seed populations, instead of recompiling p4 for
+ * each setting of DEFAULT_JUMP_VALUE and DEFAULT_JUMP_BOUND.
+ *
+ * A grid point is one jump value, one jump bound and one seed population
+ * (a distribution and a random seed, drawn as by the load generator). Each
+ * point builds a DuelingJP whose JumpPrime objects all use the point's jump
+ * value and bound, then runs a fixed number of rounds of countCollisions
+ * (up), countCollisions (down) and countInversions and totals the counts.
+ * The points are spread over worker threads that take the next unfinished
+ * point whenever they finish one, so slow points do not hold up the rest.
+ *
+ * Points with the same seeds and different jump values or bounds start in
+ * the same prime neighbourhoods and often jump into the same ones again.
+ * By default every point uses CachedJumpTraits, so a neighbourhood found by
+ * one point is reused by every other point on every thread (see
+ * PrimeCache.h); the counts are the same as without sharing.
+ *
+ * The results table has one tab-separated line per point, in grid order
+ * (distribution, then random seed, then jump bound, then jump value),
+ * after a header line. Summary lines start with '#'.
+ *
+ * OPTIONS (after --sweep):
+ *   --jump-values <list>     jump values (default 100)
+ *   --jump-bounds <list>     jump bounds (default 10)
+ *   --seeds <list>           random seeds of the populations (default 5011)
+ *   --distributions <names>  comma-separated uniform, clustered, duplicate
+ *                            (default uniform)
+ *   --population <n>         JumpPrime objects per point (default 1000)
+ *   --rounds <n>             counting rounds per point (default 10)
+ *   --min-seed <n>           smallest seed (default 1000)
+ *   --max-seed <n>           largest seed (default 100000)
+ *   --threads <n>            worker threads (default: one per core)
+ *   --no-share               search every neighbourhood in every point
+ *   --output <file>          write the table to file instead of stdout
+ * A list is comma-separated numbers or start:stop[:step] ranges (stop is
+ * included, step defaults to 1), e.g. 50:150:10,200.
+ */
+
+/// SweepConfig holds the grid and settings of a parameter sweep.
+struct SweepConfig {
+    std::vector<int> jumpValues = {100};
+    std::vector<int> jumpBounds = {10};
+    std::vector<unsigned int> randomSeeds = {5011};
+    std::vector<LoadDistribution> distributions = {LoadDistribution::Uniform};
+    int population = 1000;
+    int rounds = 10;
+    unsigned int minSeed = 1000;
+    unsigned int maxSeed = 100000;
+    int threads = 0;
+    bool sharePrimes = true;
+    std::string outputPath;
+};
+
+/// SweepResult is what one grid point counted.
+struct SweepResult {
+    LoadDistribution distribution;
+    unsigned int randomSeed;
+    int jumpBound;
+    int jumpValue;
+
+    /// Totals over every round.
+    long long upCollisions;
+    long long downCollisions;
+    long long inversions;
+
+    /// Wall-clock time of the point, including building its population.
+    double milliseconds;
+};
+
+/// parseSweepConfig reads parameter sweep options.
+/// @param [in] argc The number of arguments in argv.
+/// @param [in] argv The options, not including --sweep itself.
+/// @param [out] config The parsed settings.
+/// @return true if every option was understood and valid.
+bool parseSweepConfig(int argc, char *argv[], SweepConfig &config);
+
+/// runSweep simulates every point of the grid.
+/// @param [in] config The grid and settings.
+/// @param [out] results One result per point, in grid order.
+/// @return The wall-clock seconds the sweep took.
+double runSweep(const SweepConfig &config, std::vector<SweepResult> &results);
+
+/// writeSweepTable writes the results table.
+/// @param [in] results The results of runSweep.
+/// @param [in] output The stream to write to.
+void writeSweepTable(const std::vector<SweepResult> &results, std::ostream &output);
+
+/// runParameterSweep runs a sweep and writes its table and a summary.
+/// @param [in] config The grid and settings.
+/// @param [in] output The stream for the summary (and the table, unless
+/// config.outputPath names a file).
+/// @return false if the table file could not be written.
+bool runParameterSweep(const SweepConfig &config, std::ostream &output);
+
+/// printSweepUsage describes the parameter sweep options.
+/// @param [in] output The stream to print to.
+void printSweepUsage(std::ostream &output);
+
+
+#endif //INC_5011_P4_PARAMETERSWEEP_H
@@ -0,0 +1,110 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_PERTHREAD_H
+#define INC_5011_P4_PERTHREAD_H
+
+#include <atomic>
+
+
+/*
+ * PerThreadRegistry hands every thread its own instrumentation block
+ * (counters, histogram buckets, trace buffers) so that recording never
+ * contends with another thread, while still letting a reader walk every
+ * block to aggregate.
+ *
+ * Blocks are kept on a lock-free list and are never freed. When a thread
+ * exits its block is marked free and the next new thread reuses it, so
+ * the values recorded by exited threads stay in the aggregate and the
+ * number of blocks is bounded by the peak number of live threads.
+ *
+ * A Block type must provide:
+ *   std::atomic<bool> inUse;   // set while a thread owns the block
+ *   Block *next;               // list link, owned by the registry
+ * and must be default constructible.
+ */
+
+/// PerThreadRegistry is the list of per-thread blocks of one kind.
+template <class Block>
+class PerThreadRegistry {
+
+    std::atomic<Block *> head{nullptr};
+
+public:
+
+    /// acquire claims a free block or adds a new one to the list.
+    /// @return A block owned by the calling thread until release.
+    Block *acquire() {
+        for (Block *block = head.load(std::memory_order_acquire);
+             block != nullptr; block = block->next) {
+            bool expected = false;
+            if (!block->inUse.load(std::memory_order_relaxed) &&
+                block->inUse.compare_exchange_strong(expected, true,
+                                                     std::memory_order_acquire)) {
+                return block;
+            }
+        }
+
+        Block *block = new Block;
+        block->inUse.store(true, std::memory_order_relaxed);
+        block->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(block->next, block,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+        }
+
+        return block;
+    }
+
+    /// release returns a block to the registry when its thread exits.
+    /// @param [in] block The block to release.
+    void release(Block *block) {
+        block->inUse.store(false, std::memory_order_release);
+    }
+
+    /// forEach calls visit on every block, owned or free.
+    /// @param [in] visit Called with a const reference to each block.
+    template <class Visitor>
+    void forEach(Visitor visit) const {
+        for (const Block *block = head.load(std::memory_order_acquire);
+             block != nullptr; block = block->next) {
+            visit(*block);
+        }
+    }
+};
+
+/// ThreadBlockHandle owns a thread's block from a registry, claiming it on
+/// first use and releasing it when the thread exits. It is meant to be a
+/// thread_local object.
+template <class Block>
+class ThreadBlockHandle {
+
+    PerThreadRegistry<Block> &registry;
+    Block *block;
+
+public:
+
+    explicit ThreadBlockHandle(PerThreadRegistry<Block> &blockRegistry)
+            : registry(blockRegistry), block(nullptr) {}
+
+    ~ThreadBlockHandle() {
+        if (block != nullptr) {
+            registry.release(block);
+        }
+    }
+
+    ThreadBlockHandle(const ThreadBlockHandle &) = delete;
+    ThreadBlockHandle &operator=(const ThreadBlockHandle &) = delete;
+
+    /// get returns the thread's block, claiming one on first use.
+    Block *get() {
+        if (block == nullptr) {
+            block = registry.acquire();
+        }
+        return block;
+    }
+};
+
+
+#endif //INC_5011_P4_PERTHREAD_H
@@ -0,0 +1,285 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "PopulationJoin.h"
+
+
+namespace {
+
+/// The build-side values a partition aims for, so that its hash table
+/// (two to four slots per value) stays in the L2 cache.
+const int VALUES_PER_PARTITION = 8192;
+
+/// The most partitions a join splits into is 2^MAX_PARTITION_BITS.
+const int MAX_PARTITION_BITS = 12;
+
+/// Partitions per worker thread, so a slow partition does not leave the
+/// other threads idle at the end of the join.
+const int PARTITIONS_PER_THREAD = 4;
+
+/// Joins of fewer values than this (both sides together) run on the
+/// calling thread; starting workers would cost more than the join.
+const long long PARALLEL_JOIN_MIN_VALUES = 1 << 16;
+
+/// mixValue spreads a value over all 64 bits (the splitmix64 finalizer).
+/// The high bits pick a partition and the low bits a table slot.
+std::uint64_t mixValue(std::uint64_t value) {
+    value += 0x9e3779b97f4a7c15ull;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+/// partitionOf returns the partition a value belongs to.
+/// @param [in] value The value.
+/// @param [in] partitionBits The log2 of the number of partitions (> 0).
+template <class Value>
+int partitionOf(Value value, int partitionBits) {
+    return static_cast<int>(mixValue(value) >> (64 - partitionBits));
+}
+
+/// partitionValues groups values by partition (a counting sort on the
+/// partition number).
+/// @param [in] values The values to group.
+/// @param [in] size The number of values.
+/// @param [in] partitionBits The log2 of the number of partitions (> 0).
+/// @param [out] grouped Array of size values, grouped by partition.
+/// @param [out] starts Array of 2^partitionBits + 1 offsets: partition p
+/// is grouped[starts[p]] up to grouped[starts[p + 1]].
+template <class Value>
+void partitionValues(const Value *values, int size, int partitionBits,
+                     Value *grouped, int *starts) {
+    int partitionCount = 1 << partitionBits;
+
+    std::fill(starts, starts + partitionCount + 1, 0);
+    for (int i = 0; i < size; i++) {
+        starts[partitionOf(values[i], partitionBits) + 1]++;
+    }
+    for (int p = 0; p < partitionCount; p++) {
+        starts[p + 1] += starts[p];
+    }
+
+    int *nextPosition = new int[partitionCount];
+    std::copy(starts, starts + partitionCount, nextPosition);
+    for (int i = 0; i < size; i++) {
+        grouped[nextPosition[partitionOf(values[i], partitionBits)]++] = values[i];
+    }
+    delete[] nextPosition;
+}
+
+/// JoinTable counts the build-side values of one partition at a time in
+/// an open-addressing hash table. A worker keeps one table and reuses its
+/// memory for every partition it joins.
+template <class Value>
+class JoinTable {
+
+    /// The value in each slot, and how many build-side values equal it
+    /// (0 for an empty slot).
+    Value *keys;
+    int *counts;
+
+    /// The number of slots allocated.
+    int allocated;
+
+    /// The slots in use for the current partition, minus one.
+    int slotMask;
+
+public:
+
+    JoinTable() {
+        keys = nullptr;
+        counts = nullptr;
+        allocated = 0;
+        slotMask = 0;
+    }
+
+    ~JoinTable() {
+        delete[] keys;
+        delete[] counts;
+    }
+
+    JoinTable(const JoinTable &) = delete;
+    JoinTable &operator=(const JoinTable &) = delete;
+
+    /// build counts the values of a partition, replacing the previous one.
+    /// @param [in] values The build-side values.
+    /// @param [in] size The number of values.
+    void build(const Value *values, int size) {
+        // at least twice as many slots as values keeps probe runs short
+        int slots = 16;
+        while (slots < 2 * size) {
+            slots <<= 1;
+        }
+        if (slots > allocated) {
+            delete[] keys;
+            delete[] counts;
+            keys = new Value[slots];
+            counts = new int[slots];
+            allocated = slots;
+        }
+        slotMask = slots - 1;
+        std::fill(counts, counts + slots, 0);
+
+        for (int i = 0; i < size; i++) {
+            int slot = static_cast<int>(mixValue(values[i]) & slotMask);
+            while ((counts[slot] != 0) && (keys[slot] != values[i])) {
+                slot = (slot + 1) & slotMask;
+            }
+            keys[slot] = values[i];
+            counts[slot]++;
+        }
+    }
+
+    /// probe counts the pairs between the built partition and the values
+    /// of the other side in the same partition.
+    /// @param [in] values The probe-side values.
+    /// @param [in] size The number of values.
+    /// @return The number of (build, probe) pairs of equal values.
+    long long probe(const Value *values, int size) const {
+        long long pairs = 0;
+
+        for (int i = 0; i < size; i++) {
+            int slot = static_cast<int>(mixValue(values[i]) & slotMask);
+            while (counts[slot] != 0) {
+                if (keys[slot] == values[i]) {
+                    pairs += counts[slot];
+                    break;
+                }
+                slot = (slot + 1) & slotMask;
+            }
+        }
+
+        return pairs;
+    }
+
+};
+
+/// PartitionedJoin is a join split into partitions, shared by the threads
+/// joining it.
+template <class Value>
+struct PartitionedJoin {
+    const Value *buildValues;
+    const int *buildStarts;
+    const Value *probeValues;
+    const int *probeStarts;
+    int partitionCount;
+
+    /// The next partition a thread may take.
+    std::atomic<int> nextPartition;
+};
+
+/// joinPartitions joins partitions until none are left.
+/// @param [in,out] join The partitioned join.
+/// @param [out] pairs The number of pairs found in the partitions joined.
+template <class Value>
+void joinPartitions(PartitionedJoin<Value> &join, long long &pairs) {
+    JoinTable<Value> table;
+    long long partialPairs = 0;
+
+    int p;
+    while ((p = join.nextPartition.fetch_add(1, std::memory_order_relaxed)) <
+           join.partitionCount) {
+        int buildStart = join.buildStarts[p];
+        int probeStart = join.probeStarts[p];
+        int probeSize = join.probeStarts[p + 1] - probeStart;
+        if (probeSize == 0) {
+            continue;
+        }
+
+        table.build(join.buildValues + buildStart,
+                    join.buildStarts[p + 1] - buildStart);
+        partialPairs += table.probe(join.probeValues + probeStart, probeSize);
+    }
+
+    pairs = partialPairs;
+}
+
+} // namespace
+
+
+template <class Value>
+long long countMatchingPairs(const Value *left, int leftSize,
+                             const Value *right, int rightSize, int threads) {
+    if ((leftSize <= 0) || (rightSize <= 0)) {
+        return 0;
+    }
+
+    // build on the smaller side, stream the larger one through it
+    const Value *buildSide = left;
+    int buildSize = leftSize;
+    const Value *probeSide = right;
+    int probeSize = rightSize;
+    if (rightSize < leftSize) {
+        std::swap(buildSide, probeSide);
+        std::swap(buildSize, probeSize);
+    }
+
+    int threadCount = threads;
+    if (threadCount <= 0) {
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    if (static_cast<long long>(buildSize) + probeSize < PARALLEL_JOIN_MIN_VALUES) {
+        threadCount = 1;
+    }
+
+    int minPartitions = (threadCount > 1) ? PARTITIONS_PER_THREAD * threadCount : 1;
+    int partitionBits = 0;
+    while ((partitionBits < MAX_PARTITION_BITS) &&
+           (((buildSize >> partitionBits) > VALUES_PER_PARTITION) ||
+            ((1 << partitionBits) < minPartitions))) {
+        partitionBits++;
+    }
+
+    if (partitionBits == 0) {
+        JoinTable<Value> table;
+        table.build(buildSide, buildSize);
+        return table.probe(probeSide, probeSize);
+    }
+
+    PartitionedJoin<Value> join;
+    join.partitionCount = 1 << partitionBits;
+    Value *buildValues = new Value[buildSize];
+    Value *probeValues = new Value[probeSize];
+    int *buildStarts = new int[join.partitionCount + 1];
+    int *probeStarts = new int[join.partitionCount + 1];
+    partitionValues(buildSide, buildSize, partitionBits, buildValues, buildStarts);
+    partitionValues(probeSide, probeSize, partitionBits, probeValues, probeStarts);
+    join.buildValues = buildValues;
+    join.buildStarts = buildStarts;
+    join.probeValues = probeValues;
+    join.probeStarts = probeStarts;
+    join.nextPartition.store(0, std::memory_order_relaxed);
+
+    std::vector<long long> threadPairs(threadCount, 0);
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threadCount; t++) {
+        workers.emplace_back(joinPartitions<Value>, std::ref(join),
+                             std::ref(threadPairs[t]));
+    }
+    joinPartitions(join, threadPairs[0]);
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    delete[] buildValues;
+    delete[] probeValues;
+    delete[] buildStarts;
+    delete[] probeStarts;
+
+    long long pairs = 0;
+    for (long long partialPairs : threadPairs) {
+        pairs += partialPairs;
+    }
+    return pairs;
+}
+
+template long long countMatchingPairs<unsigned int>(
+        const unsigned int *, int, const unsigned int *, int, int);
+template long long countMatchingPairs<std::uint64_t>(
+        const std::uint64_t *, int, const std::uint64_t *, int, int);
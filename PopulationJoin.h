@@ -0,0 +1,145 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_POPULATIONJOIN_H
+#define INC_5011_P4_POPULATIONJOIN_H
+
+#include <cstdint>
+#include "DuelingJP.h"
+
+
+/*
+ * The population join compares the outputs of two DuelingJP objects, for
+ * example a control population and a treatment population, without
+ * building the combined DuelingJP that `a + b` would (which copies every
+ * JumpPrime object and searches every prime neighbourhood again).
+ *
+ * Each side is queried once, as by queryOutputs or queryInversionOutputs,
+ * and the two output arrays are joined on equal values:
+ * 1. Both arrays are split into partitions by the high bits of a hash of
+ * each value, so equal values always land in the same partition and each
+ * partition is small enough for its hash table to stay in cache.
+ * 2. Worker threads take the next unjoined partition whenever they finish
+ * one. For each partition they build a hash table of value counts from the
+ * smaller side and stream the larger side through it, adding up the
+ * counts of the values it finds.
+ *
+ * The join costs O(left + right) time and memory, where comparing every
+ * pair of outputs (as countInversions does within one DuelingJP) costs
+ * O(left * right).
+ *
+ * METHODS:
+ * 1. countMatchingPairs counts the pairs of equal values between two
+ * arrays of outputs.
+ * 2. joinCollisions counts cross collisions: pairs of a left and a right
+ * JumpPrime object whose up() (or down()) results are equal.
+ * 3. joinInversions counts cross inversions in both directions: pairs
+ * whose left up() result equals the right down() result, and pairs whose
+ * right up() result equals the left down() result.
+ *
+ * ASSUMPTIONS:
+ * 1. Counts are of (left, right) pairs, in the way countInversions counts
+ * (up, down) pairs. If three left objects and two right objects produce the
+ * same value, that value contributes 3 * 2 = 6 pairs. Collisions within one
+ * side are not counted; use countCollisions on that side for those.
+ * 2. The join queries both DuelingJP objects, so their JumpPrime objects
+ * may jump (and deactivated ones are revived), exactly as for
+ * queryOutputs and queryInversionOutputs. Left and right must be
+ * different objects; they may share a JumpPrime array as copies do, since
+ * querying detaches them first.
+ * 3. The DuelingJP objects are queried on the calling thread; only the
+ * join itself runs on the worker threads.
+ */
+
+/// CrossInversions is the inversion count of a join in each direction.
+struct CrossInversions {
+    /// Pairs whose left up() result equals the right down() result.
+    long long leftUpRightDown;
+
+    /// Pairs whose right up() result equals the left down() result.
+    long long rightUpLeftDown;
+};
+
+/// countMatchingPairs counts the pairs (i, j) with left[i] == right[j].
+/// @param [in] left The left array of values.
+/// @param [in] leftSize The number of values in left.
+/// @param [in] right The right array of values.
+/// @param [in] rightSize The number of values in right.
+/// @param [in] threads The worker threads to join with; 0 for one per core.
+/// @return The number of matching pairs.
+template <class Value>
+long long countMatchingPairs(const Value *left, int leftSize,
+                             const Value *right, int rightSize, int threads = 0);
+
+/// joinCollisions queries both DuelingJP objects in one direction and
+/// counts the pairs of a left and a right JumpPrime object with equal
+/// results.
+/// @param [in,out] left The left population.
+/// @param [in,out] right The right population.
+/// @param [in] testUp If true, queries the "up" direction, otherwise the
+/// "down" direction.
+/// @param [in] threads The worker threads to join with; 0 for one per core.
+/// @return The number of cross collisions.
+template <class Traits>
+long long joinCollisions(BasicDuelingJP<Traits> &left, BasicDuelingJP<Traits> &right,
+                         bool testUp = true, int threads = 0) {
+    typedef typename BasicDuelingJP<Traits>::Value Value;
+
+    Value *leftOutputs = new Value[left.getSize()];
+    Value *rightOutputs = new Value[right.getSize()];
+    left.queryOutputs(testUp, leftOutputs);
+    right.queryOutputs(testUp, rightOutputs);
+
+    long long pairs = countMatchingPairs(leftOutputs, left.getSize(),
+                                         rightOutputs, right.getSize(), threads);
+
+    delete[] leftOutputs;
+    delete[] rightOutputs;
+
+    return pairs;
+}
+
+/// joinInversions queries both DuelingJP objects as countInversions does
+/// (up() then down() on each JumpPrime object) and counts the pairs of a
+/// left and a right JumpPrime object whose results invert.
+/// @param [in,out] left The left population.
+/// @param [in,out] right The right population.
+/// @param [in] threads The worker threads to join with; 0 for one per core.
+/// @return The number of cross inversions in each direction.
+template <class Traits>
+CrossInversions joinInversions(BasicDuelingJP<Traits> &left,
+                               BasicDuelingJP<Traits> &right, int threads = 0) {
+    typedef typename BasicDuelingJP<Traits>::Value Value;
+
+    Value *leftUp = new Value[left.getSize()];
+    Value *leftDown = new Value[left.getSize()];
+    Value *rightUp = new Value[right.getSize()];
+    Value *rightDown = new Value[right.getSize()];
+    left.queryInversionOutputs(leftUp, leftDown);
+    right.queryInversionOutputs(rightUp, rightDown);
+
+    CrossInversions inversions;
+    inversions.leftUpRightDown = countMatchingPairs(leftUp, left.getSize(),
+                                                    rightDown, right.getSize(),
+                                                    threads);
+    inversions.rightUpLeftDown = countMatchingPairs(rightUp, right.getSize(),
+                                                    leftDown, left.getSize(),
+                                                    threads);
+
+    delete[] leftUp;
+    delete[] leftDown;
+    delete[] rightUp;
+    delete[] rightDown;
+
+    return inversions;
+}
+
+// the library compiles the joins of both number types (PopulationJoin.cpp)
+extern template long long countMatchingPairs<unsigned int>(
+        const unsigned int *, int, const unsigned int *, int, int);
+extern template long long countMatchingPairs<std::uint64_t>(
+        const std::uint64_t *, int, const std::uint64_t *, int, int);
+
+
+#endif //INC_5011_P4_POPULATIONJOIN_H
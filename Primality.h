@@ -0,0 +1,224 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_PRIMALITY_H
+#define INC_5011_P4_PRIMALITY_H
+
+#include <cstdint>
+#include "HotPathCounters.h"
+
+
+/*
+ * Primality backends for BasicJumpPrime.
+ *
+ * A backend is a class with a static `bool isPrime(Value)`, where Value is
+ * the number type of the configuration (see JumpPrime.h). It is
+ * chosen at compile time by the Primality type of a JumpPrime traits class,
+ * so the prime search of each configuration calls its backend directly.
+ *
+ * ASSUMPTIONS:
+ * 1. Every backend gives the same answers as the original trial division,
+ * including reporting 0 and 1 as prime. The downward prime search relies on
+ * this to stop at the bottom of the range instead of wrapping around, so
+ * switching backends changes the speed of a configuration but never its
+ * results.
+ */
+
+/// TrialDivisionPrimality tries every divisor below the tested number.
+/// This is the original JumpPrime primality test.
+struct TrialDivisionPrimality {
+    static bool isPrime(unsigned int testNumber) {
+        for (unsigned int i = 2; i < testNumber; i++) {
+            if (testNumber % i == 0) {
+                // divisors 2 through i were tried
+                JP_COUNT_ADD(Divisions, i - 1);
+                return false;
+            }
+        }
+
+        JP_COUNT_ADD(Divisions, (testNumber > 2) ? testNumber - 2 : 0);
+        return true;
+    }
+};
+
+/// SqrtTrialDivisionPrimality tries divisors up to the square root of the
+/// tested number.
+struct SqrtTrialDivisionPrimality {
+    static bool isPrime(unsigned int testNumber) {
+        unsigned int divisions = 0;
+
+        // i <= testNumber / i avoids overflowing i * i near the top of
+        // the range
+        for (unsigned int i = 2; i <= testNumber / i; i++) {
+            divisions++;
+            if (testNumber % i == 0) {
+                JP_COUNT_ADD(Divisions, divisions);
+                return false;
+            }
+        }
+
+        JP_COUNT_ADD(Divisions, divisions);
+        (void) divisions;
+        return true;
+    }
+};
+
+/// MillerRabinPrimality is a deterministic Miller-Rabin test. The bases
+/// 2, 7 and 61 are exact for every 32-bit number.
+struct MillerRabinPrimality {
+    static bool isPrime(unsigned int testNumber) {
+        if (testNumber < 4) {
+            // 0 and 1 are reported prime, like the trial division
+            return true;
+        }
+        if (testNumber % 2 == 0) {
+            return false;
+        }
+
+        // testNumber - 1 = oddPart * 2^twos
+        std::uint32_t oddPart = testNumber - 1;
+        int twos = 0;
+        while (oddPart % 2 == 0) {
+            oddPart /= 2;
+            twos++;
+        }
+
+        const std::uint32_t BASES[] = {2, 7, 61};
+        for (std::uint32_t base : BASES) {
+            if (base % testNumber == 0) {
+                return true;
+            }
+            if (!passesRound(testNumber, base, oddPart, twos)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    static std::uint32_t multiplyMod(std::uint32_t a, std::uint32_t b,
+                                     std::uint32_t modulus) {
+        return static_cast<std::uint32_t>(
+                static_cast<std::uint64_t>(a) * b % modulus);
+    }
+
+    static std::uint32_t powerMod(std::uint32_t base, std::uint32_t exponent,
+                                  std::uint32_t modulus) {
+        std::uint32_t result = 1;
+        base %= modulus;
+        while (exponent > 0) {
+            if (exponent & 1) {
+                result = multiplyMod(result, base, modulus);
+            }
+            base = multiplyMod(base, base, modulus);
+            exponent >>= 1;
+        }
+        return result;
+    }
+
+    /// passesRound reports whether testNumber is a strong probable prime
+    /// to one base.
+    static bool passesRound(std::uint32_t testNumber, std::uint32_t base,
+                            std::uint32_t oddPart, int twos) {
+        std::uint32_t x = powerMod(base, oddPart, testNumber);
+        if ((x == 1) || (x == testNumber - 1)) {
+            return true;
+        }
+
+        for (int r = 1; r < twos; r++) {
+            x = multiplyMod(x, x, testNumber);
+            if (x == testNumber - 1) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+/// MillerRabin64Primality is a deterministic Miller-Rabin test for 64-bit
+/// numbers. The seven bases below (Jim Sinclair's set) are exact for every
+/// 64-bit number; products are taken in 128 bits.
+struct MillerRabin64Primality {
+    static bool isPrime(std::uint64_t testNumber) {
+        if (testNumber < 4) {
+            // 0 and 1 are reported prime, like the trial division
+            return true;
+        }
+
+        // small divisors reject most candidates before the first round
+        const std::uint64_t SMALL_PRIMES[] = {2, 3, 5, 7, 11, 13, 17, 19, 23,
+                                              29, 31, 37};
+        for (std::uint64_t prime : SMALL_PRIMES) {
+            if (testNumber % prime == 0) {
+                return testNumber == prime;
+            }
+        }
+
+        // testNumber - 1 = oddPart * 2^twos
+        std::uint64_t oddPart = testNumber - 1;
+        int twos = 0;
+        while (oddPart % 2 == 0) {
+            oddPart /= 2;
+            twos++;
+        }
+
+        const std::uint64_t BASES[] = {2, 325, 9375, 28178, 450775, 9780504,
+                                       1795265022};
+        for (std::uint64_t base : BASES) {
+            std::uint64_t reducedBase = base % testNumber;
+            if (reducedBase == 0) {
+                continue;
+            }
+            if (!passesRound(testNumber, reducedBase, oddPart, twos)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    static std::uint64_t multiplyMod(std::uint64_t a, std::uint64_t b,
+                                     std::uint64_t modulus) {
+        return static_cast<std::uint64_t>(
+                static_cast<unsigned __int128>(a) * b % modulus);
+    }
+
+    static std::uint64_t powerMod(std::uint64_t base, std::uint64_t exponent,
+                                  std::uint64_t modulus) {
+        std::uint64_t result = 1;
+        while (exponent > 0) {
+            if (exponent & 1) {
+                result = multiplyMod(result, base, modulus);
+            }
+            base = multiplyMod(base, base, modulus);
+            exponent >>= 1;
+        }
+        return result;
+    }
+
+    /// passesRound reports whether testNumber is a strong probable prime
+    /// to one base.
+    static bool passesRound(std::uint64_t testNumber, std::uint64_t base,
+                            std::uint64_t oddPart, int twos) {
+        std::uint64_t x = powerMod(base, oddPart, testNumber);
+        if ((x == 1) || (x == testNumber - 1)) {
+            return true;
+        }
+
+        for (int r = 1; r < twos; r++) {
+            x = multiplyMod(x, x, testNumber);
+            if (x == testNumber - 1) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+
+#endif //INC_5011_P4_PRIMALITY_H
@@ -0,0 +1,26 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include "PrimeCache.h"
+
+
+std::atomic<std::uint64_t> SharedPrimeCache::slots[SLOT_COUNT];
+
+void SharedPrimeCache::storeGap(std::uint32_t gapStart, std::uint32_t gapEnd) {
+    // a gap longer than the table would overwrite its own slots
+    if ((gapEnd <= gapStart) || (gapEnd - gapStart > SLOT_COUNT)) {
+        return;
+    }
+
+    std::uint64_t entry = (static_cast<std::uint64_t>(gapStart) << 32) | gapEnd;
+    for (std::uint32_t number = gapStart; number != gapEnd; number++) {
+        slots[number & (SLOT_COUNT - 1)].store(entry, std::memory_order_relaxed);
+    }
+}
+
+void SharedPrimeCache::clear() {
+    for (std::uint32_t i = 0; i < SLOT_COUNT; i++) {
+        slots[i].store(0, std::memory_order_relaxed);
+    }
+}
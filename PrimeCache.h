@@ -0,0 +1,131 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_PRIMECACHE_H
+#define INC_5011_P4_PRIMECACHE_H
+
+#include <atomic>
+#include <cstdint>
+
+
+/*
+ * Prime neighbourhood caches for BasicJumpPrime.
+ *
+ * Every jump of a JumpPrime object searches for the primes on either side
+ * of its new number. A cache is chosen by the PrimeCache type of a traits
+ * class (see JumpPrime.h) and remembers those neighbourhoods, so objects
+ * that land between the same two primes (in the same population or in
+ * another configuration running at the same time) search only once.
+ *
+ * A cache is a class with two static members:
+ *   bool find(Value number, Value &lowerPrime, Value &upperPrime);
+ *   void store(Value lowerPrime, Value number, Value upperPrime,
+ *              bool numberIsPrime);
+ * find reports the primes around a number if they are known; store records
+ * the result of a search (with numberIsPrime telling whether the number
+ * itself is prime) and is only called with lowerPrime < number < upperPrime.
+ * ENABLED tells BasicJumpPrime whether to call store at all.
+ *
+ * SharedPrimeCache is one process-wide table of gaps between consecutive
+ * primes. Slot x holds a gap [p, q) with p <= x < q, written for every x
+ * the gap covers, so looking up a number is one or two loads. Slots are
+ * addressed by the low bits of x, so a gap fills neighbouring slots and a
+ * slot is only overwritten by a gap about SLOT_COUNT away. Each slot is a
+ * single 64-bit word holding both primes, so it is read and written whole
+ * without locks; a slot is only trusted if its gap contains the number
+ * looked up, so an overwritten slot is simply a miss.
+ *
+ * ASSUMPTIONS:
+ * 1. Every primality backend gives the same answers (see Primality.h), so
+ * configurations with different backends can share the table.
+ * 2. SharedPrimeCache holds numbers of at most 32 bits.
+ */
+
+/// NoPrimeCache searches for every neighbourhood; it is the default.
+struct NoPrimeCache {
+    static constexpr bool ENABLED = false;
+
+    template <class Value>
+    static bool find(Value, Value &, Value &) {
+        return false;
+    }
+
+    template <class Value>
+    static void store(Value, Value, Value, bool) {
+    }
+};
+
+/// SharedPrimeCache remembers prime neighbourhoods across every JumpPrime
+/// object of the process.
+class SharedPrimeCache {
+
+    /// The number of slots; a power of two.
+    static constexpr std::uint32_t SLOT_COUNT = 1u << 21;
+
+    /// Each slot holds a gap as (p << 32) | q; 0 is an empty slot.
+    static std::atomic<std::uint64_t> slots[SLOT_COUNT];
+
+    /// findGap loads the gap covering a number.
+    /// @return true if slot x holds a gap containing x.
+    static bool findGap(std::uint32_t number, std::uint32_t &gapStart,
+                        std::uint32_t &gapEnd) {
+        std::uint64_t entry = slots[number & (SLOT_COUNT - 1)]
+                .load(std::memory_order_relaxed);
+        gapStart = static_cast<std::uint32_t>(entry >> 32);
+        gapEnd = static_cast<std::uint32_t>(entry);
+        return (gapStart <= number) && (number < gapEnd);
+    }
+
+    /// storeGap writes a gap [gapStart, gapEnd) to every slot it covers.
+    static void storeGap(std::uint32_t gapStart, std::uint32_t gapEnd);
+
+public:
+
+    static constexpr bool ENABLED = true;
+
+    template <class Value>
+    static bool find(Value number, Value &lowerPrime, Value &upperPrime) {
+        static_assert(sizeof(Value) <= 4, "SharedPrimeCache holds 32-bit numbers");
+
+        std::uint32_t gapStart;
+        std::uint32_t gapEnd;
+        if (!findGap(number, gapStart, gapEnd)) {
+            return false;
+        }
+
+        // a prime number starts its own gap; its lower prime starts the
+        // gap before it
+        std::uint32_t lowerStart = gapStart;
+        if (gapStart == number) {
+            std::uint32_t lowerEnd;
+            if ((number == 0) || !findGap(number - 1, lowerStart, lowerEnd)) {
+                return false;
+            }
+        }
+
+        lowerPrime = lowerStart;
+        upperPrime = gapEnd;
+        return true;
+    }
+
+    template <class Value>
+    static void store(Value lowerPrime, Value number, Value upperPrime,
+                      bool numberIsPrime) {
+        static_assert(sizeof(Value) <= 4, "SharedPrimeCache holds 32-bit numbers");
+
+        if (numberIsPrime) {
+            storeGap(lowerPrime, number);
+            storeGap(number, upperPrime);
+        } else {
+            storeGap(lowerPrime, upperPrime);
+        }
+    }
+
+    /// clear empties the table.
+    static void clear();
+
+};
+
+
+#endif //INC_5011_P4_PRIMECACHE_H
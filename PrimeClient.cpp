@@ -0,0 +1,123 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "PrimeClient.h"
+
+
+namespace {
+
+/// sendAll writes a whole buffer to a blocking socket.
+bool sendAll(int socketFd, const char *bytes, std::size_t length) {
+    while (length > 0) {
+        ssize_t bytesWritten = send(socketFd, bytes, length, MSG_NOSIGNAL);
+        if (bytesWritten < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes += bytesWritten;
+        length -= static_cast<std::size_t>(bytesWritten);
+    }
+
+    return true;
+}
+
+/// receiveAll reads a whole buffer from a blocking socket.
+bool receiveAll(int socketFd, char *bytes, std::size_t length) {
+    while (length > 0) {
+        ssize_t bytesRead = recv(socketFd, bytes, length, 0);
+        if (bytesRead <= 0) {
+            if ((bytesRead < 0) && (errno == EINTR)) {
+                continue;
+            }
+            return false;
+        }
+        bytes += bytesRead;
+        length -= static_cast<std::size_t>(bytesRead);
+    }
+
+    return true;
+}
+
+} // namespace
+
+
+PrimeClient::PrimeClient() {
+    socketFd = -1;
+}
+
+PrimeClient::~PrimeClient() {
+    disconnect();
+}
+
+bool PrimeClient::connectTo(const std::string &path) {
+    disconnect();
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    socketFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if ((socketFd < 0) ||
+        (connect(socketFd, reinterpret_cast<sockaddr *>(&address),
+                 sizeof(address)) != 0)) {
+        disconnect();
+        return false;
+    }
+
+    return true;
+}
+
+bool PrimeClient::lookup(const std::uint64_t *values, int count,
+                         PrimeResponse *responses) {
+    if (socketFd < 0) {
+        return false;
+    }
+
+    PrimeRequest *requests = new PrimeRequest[count];
+    for (int i = 0; i < count; i++) {
+        requests[i].requestId = static_cast<std::uint32_t>(i);
+        requests[i].flags = 0;
+        requests[i].value = values[i];
+    }
+
+    // the server keeps reading while it answers, so every request can be
+    // written before the first response is read
+    bool lookupOk = sendAll(socketFd, reinterpret_cast<const char *>(requests),
+                            sizeof(PrimeRequest) * count);
+
+    for (int i = 0; lookupOk && (i < count); i++) {
+        PrimeResponse response;
+        lookupOk = receiveAll(socketFd, reinterpret_cast<char *>(&response),
+                              sizeof(response)) &&
+                   (response.requestId < static_cast<std::uint32_t>(count));
+        if (lookupOk) {
+            responses[response.requestId] = response;
+        }
+    }
+
+    delete[] requests;
+
+    if (!lookupOk) {
+        disconnect();
+    }
+
+    return lookupOk;
+}
+
+void PrimeClient::disconnect() {
+    if (socketFd >= 0) {
+        close(socketFd);
+        socketFd = -1;
+    }
+}
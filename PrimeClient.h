@@ -0,0 +1,61 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_PRIMECLIENT_H
+#define INC_5011_P4_PRIMECLIENT_H
+
+#include <cstdint>
+#include <string>
+#include "PrimeProtocol.h"
+
+
+/*
+ * The PrimeClient sends nearest-prime requests to a PrimeServer (see
+ * PrimeProtocol.h) over one connection.
+ *
+ * lookup() writes every request of a call before reading the responses, so
+ * a call with many values costs one round trip and its requests can be
+ * answered in a single server batch.
+ *
+ * ASSUMPTIONS:
+ * 1. A client is used by one thread at a time; use one client per thread.
+ */
+
+/// PrimeClient is a blocking client of the nearest-prime service.
+class PrimeClient {
+
+    /// The connected socket, or -1.
+    int socketFd;
+
+public:
+
+    /// PrimeClient Constructor creates an unconnected client.
+    PrimeClient();
+
+    /// PrimeClient Destructor closes the connection.
+    ~PrimeClient();
+
+    PrimeClient(const PrimeClient &) = delete;
+    PrimeClient &operator=(const PrimeClient &) = delete;
+
+    /// connectTo connects to a server.
+    /// @param [in] path The server's socket path.
+    /// @return true if connected.
+    bool connectTo(const std::string &path = PRIME_DEFAULT_SOCKET_PATH);
+
+    /// lookup asks for the nearest primes around each value.
+    /// @param [in] values The values to look around.
+    /// @param [in] count The number of values.
+    /// @param [out] responses Array of count responses, in value order.
+    /// @return false if the connection failed; the client is then
+    /// disconnected.
+    bool lookup(const std::uint64_t *values, int count, PrimeResponse *responses);
+
+    /// disconnect closes the connection.
+    void disconnect();
+
+};
+
+
+#endif //INC_5011_P4_PRIMECLIENT_H
@@ -0,0 +1,72 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_PRIMEPROTOCOL_H
+#define INC_5011_P4_PRIMEPROTOCOL_H
+
+#include <cstdint>
+
+
+/*
+ * The binary protocol of the nearest-prime service (PrimeServer and
+ * PrimeClient).
+ *
+ * A client connects to the server's Unix domain stream socket and writes
+ * any number of fixed-size PrimeRequest records; the server answers each
+ * with one PrimeResponse record. Responses on a connection come back in the
+ * order of its requests, and a client may have many requests in flight.
+ * Both ends run on the same host, so the records are in host byte order.
+ *
+ * ASSUMPTIONS:
+ * 1. The primes are those of the 64-bit JumpPrime configuration
+ * (JumpPrime64), so any 64-bit value can be looked up.
+ */
+
+/// The socket path used when none is given.
+const char *const PRIME_DEFAULT_SOCKET_PATH = "/tmp/jumpprime-primes.sock";
+
+/// PrimeStatus describes which primes of a response are valid.
+enum PrimeStatus : std::uint32_t {
+    /// Both lowerPrime and upperPrime are valid.
+    PrimeOk = 0,
+
+    /// There is no prime below the value (it is 2 or less); lowerPrime is 0.
+    PrimeNoLower = 1,
+
+    /// There is no 64-bit prime above the value; upperPrime is 0.
+    PrimeNoUpper = 2
+};
+
+/// PrimeRequest asks for the nearest primes around a value.
+struct PrimeRequest {
+    /// Chosen by the client and echoed in the response.
+    std::uint32_t requestId;
+
+    /// Reserved; must be 0.
+    std::uint32_t flags;
+
+    /// The value to look around.
+    std::uint64_t value;
+};
+
+/// PrimeResponse carries the nearest primes below and above a value.
+struct PrimeResponse {
+    /// The requestId of the request answered.
+    std::uint32_t requestId;
+
+    /// A PrimeStatus.
+    std::uint32_t status;
+
+    /// The greatest prime less than the value.
+    std::uint64_t lowerPrime;
+
+    /// The smallest prime greater than the value.
+    std::uint64_t upperPrime;
+};
+
+static_assert(sizeof(PrimeRequest) == 16, "PrimeRequest is 16 bytes on the wire");
+static_assert(sizeof(PrimeResponse) == 24, "PrimeResponse is 24 bytes on the wire");
+
+
+#endif //INC_5011_P4_PRIMEPROTOCOL_H
@@ -0,0 +1,485 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <numeric>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "JumpPrime.h"
+#include "PrimeServer.h"
+
+
+namespace {
+
+/// The epoll ids of the listening socket and the timer; connection ids
+/// start after them.
+const std::uint64_t LISTEN_ID = 0;
+const std::uint64_t TIMER_ID = 1;
+const std::uint64_t FIRST_CONNECTION_ID = 2;
+
+/// The most bytes read from one connection per readConnection call.
+const std::size_t MAX_READ_BYTES = 256 * 1024;
+
+/// The most unwritten response bytes a connection may have before the
+/// server stops reading its requests.
+const std::size_t MAX_QUEUED_OUTPUT = 1024 * 1024;
+
+/// The greatest 64-bit prime; nothing above it has an upper prime.
+const std::uint64_t LARGEST_PRIME = 18446744073709551557ull;
+
+/// lookupValue answers one value with the JumpPrime64 prime search.
+/// @param [in] value The value to look around.
+/// @param [out] response The response to fill in.
+void lookupValue(std::uint64_t value, PrimeResponse &response) {
+    response.status = PrimeOk;
+    response.lowerPrime = 0;
+    response.upperPrime = 0;
+
+    // 0 and 1 are reported prime by the search, so it is not asked below 3
+    // for a lower prime or below 2 for an upper one
+    if (value <= 2) {
+        response.status |= PrimeNoLower;
+    } else {
+        response.lowerPrime = JumpPrime64::previousPrime(value);
+    }
+
+    if (value >= LARGEST_PRIME) {
+        response.status |= PrimeNoUpper;
+    } else if (value < 2) {
+        response.upperPrime = 2;
+    } else {
+        response.upperPrime = JumpPrime64::nextPrime(value);
+    }
+}
+
+/// microseconds converts a steady clock duration for printing.
+double microseconds(std::chrono::steady_clock::duration elapsed) {
+    return std::chrono::duration<double, std::micro>(elapsed).count();
+}
+
+} // namespace
+
+
+void PrimeServer::lookupBatch(const std::uint64_t *values, int count,
+                              PrimeResponse *responses) {
+    // visit the values in order so neighbours can share a search
+    int *order = new int[count];
+    std::iota(order, order + count, 0);
+    std::sort(order, order + count, [values](int first, int second) {
+        return values[first] < values[second];
+    });
+
+    const PrimeResponse *previous = nullptr;
+    std::uint64_t previousValue = 0;
+    bool previousIsPrime = false;
+
+    for (int k = 0; k < count; k++) {
+        int i = order[k];
+        std::uint64_t value = values[i];
+        bool valueIsPrime;
+
+        if ((previous != nullptr) && (value == previousValue)) {
+            // a repeated value
+            responses[i].status = previous->status;
+            responses[i].lowerPrime = previous->lowerPrime;
+            responses[i].upperPrime = previous->upperPrime;
+            continue;
+        }
+
+        if ((previous != nullptr) && (previous->status == PrimeOk) &&
+            (value < previous->upperPrime)) {
+            // no prime lies between the previous value and its upper
+            // prime, so this value is in the same gap
+            responses[i].status = PrimeOk;
+            responses[i].lowerPrime = previousIsPrime ? previousValue :
+                                                        previous->lowerPrime;
+            responses[i].upperPrime = previous->upperPrime;
+            valueIsPrime = false;
+        } else {
+            lookupValue(value, responses[i]);
+            valueIsPrime = JumpPrime64::isPrimeNumber(value);
+        }
+
+        previous = &responses[i];
+        previousValue = value;
+        previousIsPrime = valueIsPrime;
+    }
+
+    delete[] order;
+}
+
+
+PrimeServer::PrimeServer(int windowMicroseconds, int batchLimit) {
+    batchWindow = std::max(windowMicroseconds, 0);
+    maxBatch = std::max(batchLimit, 1);
+    listenFd = -1;
+    epollFd = -1;
+    timerFd = -1;
+    nextConnectionId = FIRST_CONNECTION_ID;
+    requestCount = 0;
+    batchCount = 0;
+    startTime = std::chrono::steady_clock::now();
+}
+
+PrimeServer::~PrimeServer() {
+    while (!connections.empty()) {
+        closeConnection(connections.begin()->first);
+    }
+
+    if (listenFd >= 0) {
+        close(listenFd);
+        unlink(socketPath.c_str());
+    }
+    if (timerFd >= 0) {
+        close(timerFd);
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+}
+
+bool PrimeServer::listenOn(const std::string &path) {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if ((listenFd >= 0) || (path.size() >= sizeof(address.sun_path))) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+    // a file left by an earlier server would make bind fail
+    unlink(path.c_str());
+
+    epoll_event listenEvent = {};
+    listenEvent.events = EPOLLIN;
+    listenEvent.data.u64 = LISTEN_ID;
+    epoll_event timerEvent = {};
+    timerEvent.events = EPOLLIN;
+    timerEvent.data.u64 = TIMER_ID;
+
+    bool listening = (listenFd >= 0) && (epollFd >= 0) && (timerFd >= 0) &&
+            (bind(listenFd, reinterpret_cast<sockaddr *>(&address),
+                  sizeof(address)) == 0) &&
+            (listen(listenFd, SOMAXCONN) == 0) &&
+            (epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent) == 0) &&
+            (epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &timerEvent) == 0);
+
+    if (!listening) {
+        if (listenFd >= 0) {
+            close(listenFd);
+            listenFd = -1;
+        }
+        return false;
+    }
+
+    socketPath = path;
+    startTime = std::chrono::steady_clock::now();
+    return true;
+}
+
+void PrimeServer::acceptConnections() {
+    while (true) {
+        int socketFd = accept4(listenFd, nullptr, nullptr,
+                               SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (socketFd < 0) {
+            return;
+        }
+
+        std::uint64_t connectionId = nextConnectionId++;
+
+        epoll_event connectionEvent = {};
+        connectionEvent.events = EPOLLIN | EPOLLRDHUP;
+        connectionEvent.data.u64 = connectionId;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, socketFd, &connectionEvent) != 0) {
+            close(socketFd);
+            continue;
+        }
+
+        Connection &connection = connections[connectionId];
+        connection.socketFd = socketFd;
+        connection.outputOffset = 0;
+        connection.waitingToWrite = false;
+        connection.readClosed = false;
+        connection.readPaused = false;
+    }
+}
+
+bool PrimeServer::readConnection(std::uint64_t connectionId) {
+    Connection &connection = connections[connectionId];
+
+    // a client that does not read its responses is not read from either;
+    // trying to write notices if it has gone away
+    if (isOutputBacklogged(connection)) {
+        if (!connection.readPaused) {
+            watchConnection(connectionId, true);
+        }
+        return writeConnection(connectionId);
+    }
+
+    char readBuffer[64 * 1024];
+    bool peerClosed = false;
+
+    // stop once a full batch is waiting; epoll reports the rest again
+    while ((connection.inputBytes.size() < MAX_READ_BYTES) &&
+           (pendingRequests.size() + connection.inputBytes.size() / sizeof(PrimeRequest) <
+            static_cast<std::size_t>(maxBatch))) {
+        ssize_t bytesRead = recv(connection.socketFd, readBuffer,
+                                 sizeof(readBuffer), 0);
+        if (bytesRead > 0) {
+            connection.inputBytes.insert(connection.inputBytes.end(),
+                                         readBuffer, readBuffer + bytesRead);
+        } else if ((bytesRead < 0) && (errno == EINTR)) {
+            continue;
+        } else {
+            peerClosed = (bytesRead == 0) ||
+                         ((errno != EAGAIN) && (errno != EWOULDBLOCK));
+            break;
+        }
+    }
+
+    // queue every whole request
+    std::size_t wholeRequests = connection.inputBytes.size() / sizeof(PrimeRequest);
+    std::chrono::steady_clock::time_point received = std::chrono::steady_clock::now();
+
+    if ((wholeRequests > 0) && pendingRequests.empty() && (batchWindow > 0)) {
+        armTimer(batchWindow);
+    }
+
+    for (std::size_t i = 0; i < wholeRequests; i++) {
+        PendingRequest pending;
+        pending.connectionId = connectionId;
+        std::memcpy(&pending.request,
+                    connection.inputBytes.data() + i * sizeof(PrimeRequest),
+                    sizeof(PrimeRequest));
+        pending.received = received;
+        pendingRequests.push_back(pending);
+    }
+    connection.inputBytes.erase(connection.inputBytes.begin(),
+                                connection.inputBytes.begin() +
+                                wholeRequests * sizeof(PrimeRequest));
+
+    if (peerClosed) {
+        connection.readClosed = true;
+        watchConnection(connectionId, connection.waitingToWrite);
+    }
+
+    // answering may write to (and close) this connection
+    if (peerClosed || (static_cast<int>(pendingRequests.size()) >= maxBatch)) {
+        answerBatch();
+    }
+
+    auto found = connections.find(connectionId);
+    if ((found != connections.end()) && found->second.readClosed &&
+        found->second.outputBytes.empty()) {
+        closeConnection(connectionId);
+    }
+
+    return connections.count(connectionId) != 0;
+}
+
+bool PrimeServer::writeConnection(std::uint64_t connectionId) {
+    auto found = connections.find(connectionId);
+    if (found == connections.end()) {
+        return false;
+    }
+    Connection &connection = found->second;
+
+    while (connection.outputOffset < connection.outputBytes.size()) {
+        ssize_t bytesWritten = send(connection.socketFd,
+                                    connection.outputBytes.data() + connection.outputOffset,
+                                    connection.outputBytes.size() - connection.outputOffset,
+                                    MSG_NOSIGNAL);
+        if (bytesWritten > 0) {
+            connection.outputOffset += static_cast<std::size_t>(bytesWritten);
+        } else if ((bytesWritten < 0) && (errno == EINTR)) {
+            continue;
+        } else if ((bytesWritten < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+            // finish when the socket has room again, reading again once
+            // the backlog is under the cap
+            if (!connection.waitingToWrite ||
+                (connection.readPaused != isOutputBacklogged(connection))) {
+                watchConnection(connectionId, true);
+            }
+            return true;
+        } else {
+            closeConnection(connectionId);
+            return false;
+        }
+    }
+
+    connection.outputBytes.clear();
+    connection.outputOffset = 0;
+
+    if (connection.readClosed) {
+        closeConnection(connectionId);
+        return false;
+    }
+    if (connection.waitingToWrite) {
+        watchConnection(connectionId, false);
+    }
+
+    return true;
+}
+
+void PrimeServer::closeConnection(std::uint64_t connectionId) {
+    auto found = connections.find(connectionId);
+    if (found != connections.end()) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, found->second.socketFd, nullptr);
+        close(found->second.socketFd);
+        connections.erase(found);
+    }
+}
+
+void PrimeServer::watchConnection(std::uint64_t connectionId, bool watchOutput) {
+    Connection &connection = connections[connectionId];
+
+    connection.readPaused = !connection.readClosed && isOutputBacklogged(connection);
+    bool watchInput = !connection.readClosed && !connection.readPaused;
+
+    epoll_event connectionEvent = {};
+    connectionEvent.events =
+            (watchInput ? static_cast<std::uint32_t>(EPOLLIN | EPOLLRDHUP) : 0u) |
+            (watchOutput ? static_cast<std::uint32_t>(EPOLLOUT) : 0u);
+    connectionEvent.data.u64 = connectionId;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.socketFd, &connectionEvent);
+
+    connection.waitingToWrite = watchOutput;
+}
+
+bool PrimeServer::isOutputBacklogged(const Connection &connection) {
+    return connection.outputBytes.size() - connection.outputOffset > MAX_QUEUED_OUTPUT;
+}
+
+void PrimeServer::armTimer(int microseconds) {
+    itimerspec timerSetting = {};
+    timerSetting.it_value.tv_sec = microseconds / 1000000;
+    timerSetting.it_value.tv_nsec = (microseconds % 1000000) * 1000L;
+    timerfd_settime(timerFd, 0, &timerSetting, nullptr);
+}
+
+void PrimeServer::answerBatch() {
+    int batchSize = static_cast<int>(pendingRequests.size());
+    if (batchSize == 0) {
+        return;
+    }
+    if (batchWindow > 0) {
+        armTimer(0);
+    }
+
+    std::uint64_t *values = new std::uint64_t[batchSize];
+    PrimeResponse *responses = new PrimeResponse[batchSize];
+    for (int i = 0; i < batchSize; i++) {
+        values[i] = pendingRequests[i].request.value;
+    }
+
+    lookupBatch(values, batchSize, responses);
+
+    std::vector<std::uint64_t> answeredConnections;
+    std::chrono::steady_clock::time_point answered = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < batchSize; i++) {
+        auto found = connections.find(pendingRequests[i].connectionId);
+        if (found == connections.end()) {
+            continue;
+        }
+
+        responses[i].requestId = pendingRequests[i].request.requestId;
+        const char *responseBytes = reinterpret_cast<const char *>(&responses[i]);
+        std::vector<char> &outputBytes = found->second.outputBytes;
+        if (outputBytes.empty()) {
+            answeredConnections.push_back(found->first);
+        }
+        outputBytes.insert(outputBytes.end(), responseBytes,
+                           responseBytes + sizeof(PrimeResponse));
+
+        std::chrono::nanoseconds latency = answered - pendingRequests[i].received;
+        latencies.add(LatencyHistogram::bucketIndex(
+                static_cast<std::uint64_t>(latency.count())), 1);
+    }
+
+    requestCount += static_cast<std::uint64_t>(batchSize);
+    batchCount++;
+    pendingRequests.clear();
+
+    delete[] values;
+    delete[] responses;
+
+    for (std::uint64_t connectionId : answeredConnections) {
+        writeConnection(connectionId);
+    }
+}
+
+bool PrimeServer::run(const std::atomic<bool> &stopRequested) {
+    if (listenFd < 0) {
+        return false;
+    }
+
+    const int MAX_EVENTS = 64;
+    epoll_event events[MAX_EVENTS];
+
+    while (!stopRequested.load(std::memory_order_relaxed)) {
+        int readyCount = epoll_wait(epollFd, events, MAX_EVENTS, 100);
+        if (readyCount < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        bool windowEnded = false;
+
+        for (int e = 0; e < readyCount; e++) {
+            std::uint64_t eventId = events[e].data.u64;
+
+            if (eventId == LISTEN_ID) {
+                acceptConnections();
+            } else if (eventId == TIMER_ID) {
+                std::uint64_t expirations;
+                ssize_t bytesRead = read(timerFd, &expirations, sizeof(expirations));
+                windowEnded = windowEnded || (bytesRead == sizeof(expirations));
+            } else if (connections.count(eventId) != 0) {
+                if ((events[e].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) &&
+                    !readConnection(eventId)) {
+                    continue;
+                }
+                if (events[e].events & EPOLLOUT) {
+                    writeConnection(eventId);
+                }
+            }
+        }
+
+        if (windowEnded || (batchWindow == 0)) {
+            answerBatch();
+        }
+    }
+
+    // answer what was read before the stop
+    answerBatch();
+    return true;
+}
+
+void PrimeServer::reportStats(std::ostream &output) const {
+    double seconds = microseconds(std::chrono::steady_clock::now() - startTime) / 1e6;
+
+    output << "Prime server: requests=" << requestCount
+           << "  batches=" << batchCount
+           << "  mean batch=" << (batchCount == 0 ? 0.0 :
+                                  static_cast<double>(requestCount) /
+                                  static_cast<double>(batchCount))
+           << "  requests/s=" << (seconds > 0 ? requestCount / seconds : 0.0)
+           << "  p50=" << latencies.percentile(0.50) / 1000.0 << "us"
+           << "  p90=" << latencies.percentile(0.90) / 1000.0 << "us"
+           << "  p99=" << latencies.percentile(0.99) / 1000.0 << "us"
+           << "  max=" << latencies.maximum() / 1000.0 << "us"
+           << "\n";
+}
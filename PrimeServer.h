@@ -0,0 +1,194 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_PRIMESERVER_H
+#define INC_5011_P4_PRIMESERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "LatencyHistogram.h"
+#include "PrimeProtocol.h"
+
+
+/*
+ * The PrimeServer answers nearest-prime requests (see PrimeProtocol.h) on a
+ * Unix domain socket, using the JumpPrime prime search.
+ *
+ * All I/O runs on one thread around an epoll set holding the listening
+ * socket, every client connection and a timer. Requests read from any
+ * connection join the pending batch; the first request of a batch arms the
+ * timer, and the batch is answered when the timer fires (the batch window)
+ * or when a read brings it to the maximum batch size. A window of 0 answers
+ * whatever was read in one pass over the ready connections.
+ *
+ * A batch is answered by one lookupBatch call, which sorts the values and
+ * walks them in order: values that fall in the same gap between primes share
+ * one prime search, and repeated values are looked up once.
+ *
+ * METHODS:
+ * 1. listenOn() binds the socket; run() serves until the stop flag is set.
+ * 2. reportStats() writes the requests, batches, throughput and the
+ * latency (from reading a request to queuing its response) so far.
+ *
+ * ASSUMPTIONS:
+ * 1. listenOn() replaces any file at the socket path, so only one server
+ * should be started per path.
+ * 2. A client may close its side of the connection after its last request
+ * and still read every response; a trailing partial request is dropped.
+ * 3. Memory per connection is bounded: at most 256 KB is read from a
+ * connection at a time, and a client whose unwritten responses pass 1 MB
+ * (one that sends faster than it reads) is not read from until they drain
+ * below it; its further requests wait in the socket.
+ */
+
+/// PrimeServer serves nearest-prime lookups over a Unix domain socket.
+class PrimeServer {
+
+    /// Connection is one client connection.
+    struct Connection {
+        /// The connection's socket.
+        int socketFd;
+
+        /// Bytes read but not yet making up a whole request.
+        std::vector<char> inputBytes;
+
+        /// Responses not yet written, starting at outputOffset.
+        std::vector<char> outputBytes;
+        std::size_t outputOffset;
+
+        /// true while the socket is registered for EPOLLOUT.
+        bool waitingToWrite;
+
+        /// true once the client has closed its side; the connection is
+        /// closed when its queued responses are written.
+        bool readClosed;
+
+        /// true while input is not watched because too many responses
+        /// are waiting to be written.
+        bool readPaused;
+    };
+
+    /// PendingRequest is a request waiting for its batch.
+    struct PendingRequest {
+        /// The id of the connection that sent it.
+        std::uint64_t connectionId;
+
+        /// The request.
+        PrimeRequest request;
+
+        /// When it was read.
+        std::chrono::steady_clock::time_point received;
+    };
+
+    /// The batch window in microseconds.
+    int batchWindow;
+
+    /// The most requests answered in one batch.
+    int maxBatch;
+
+    /// The listening socket, epoll set and batch timer.
+    int listenFd;
+    int epollFd;
+    int timerFd;
+
+    /// The path the listening socket is bound to.
+    std::string socketPath;
+
+    /// The open connections by id. Ids are never reused, so a response
+    /// is never sent to a later connection that reuses a closed socket.
+    std::unordered_map<std::uint64_t, Connection> connections;
+    std::uint64_t nextConnectionId;
+
+    /// The requests of the current batch.
+    std::vector<PendingRequest> pendingRequests;
+
+    /// Statistics.
+    std::uint64_t requestCount;
+    std::uint64_t batchCount;
+    std::chrono::steady_clock::time_point startTime;
+    LatencyHistogram latencies;
+
+    /// acceptConnections accepts every waiting connection.
+    void acceptConnections();
+
+    /// readConnection reads what a connection has sent and queues its
+    /// complete requests.
+    /// @return false if the connection was closed.
+    bool readConnection(std::uint64_t connectionId);
+
+    /// writeConnection writes as much of a connection's queued responses
+    /// as the socket takes, waiting for EPOLLOUT if it fills.
+    /// @return false if the connection was closed.
+    bool writeConnection(std::uint64_t connectionId);
+
+    /// closeConnection closes a connection and forgets it.
+    void closeConnection(std::uint64_t connectionId);
+
+    /// watchConnection sets the events epoll reports for a connection:
+    /// input unless the client closed its side or its responses are
+    /// backlogged, and output if requested.
+    void watchConnection(std::uint64_t connectionId, bool watchOutput);
+
+    /// isOutputBacklogged reports whether a connection has more unwritten
+    /// responses than the server queues before it stops reading.
+    static bool isOutputBacklogged(const Connection &connection);
+
+    /// armTimer starts (or, with 0, stops) the batch timer.
+    void armTimer(int microseconds);
+
+    /// answerBatch looks up the pending requests and queues the responses.
+    void answerBatch();
+
+public:
+
+    /// The batch window used when none is given, in microseconds.
+    static constexpr int DEFAULT_BATCH_WINDOW = 200;
+
+    /// The maximum batch size used when none is given.
+    static constexpr int DEFAULT_MAX_BATCH = 4096;
+
+    /// PrimeServer Constructor creates a server that is not yet listening.
+    /// @param [in] windowMicroseconds The batch window (0 for none).
+    /// @param [in] batchLimit The most requests answered in one batch.
+    explicit PrimeServer(int windowMicroseconds = DEFAULT_BATCH_WINDOW,
+                         int batchLimit = DEFAULT_MAX_BATCH);
+
+    /// PrimeServer Destructor closes every connection and removes the
+    /// socket file.
+    ~PrimeServer();
+
+    PrimeServer(const PrimeServer &) = delete;
+    PrimeServer &operator=(const PrimeServer &) = delete;
+
+    /// listenOn binds and listens on a Unix domain socket.
+    /// @param [in] path The socket path.
+    /// @return true if the server is listening.
+    bool listenOn(const std::string &path);
+
+    /// run serves requests until stopRequested becomes true.
+    /// @param [in] stopRequested Checked at least every 100 ms.
+    /// @return false if the server was not listening or epoll failed.
+    bool run(const std::atomic<bool> &stopRequested);
+
+    /// reportStats writes the statistics gathered so far.
+    /// @param [in] output The stream to write to.
+    void reportStats(std::ostream &output) const;
+
+    /// lookupBatch answers a batch of values.
+    /// @param [in] values The values to look around.
+    /// @param [in] count The number of values.
+    /// @param [out] responses Array of count responses; their status and
+    /// primes are filled in, requestId is left alone.
+    static void lookupBatch(const std::uint64_t *values, int count,
+                            PrimeResponse *responses);
+
+};
+
+
+#endif //INC_5011_P4_PRIMESERVER_H
@@ -0,0 +1,424 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "ShardedDuelingJP.h"
+#include "HotPathCounters.h"
+#include "LatencyHistogram.h"
+#include "TraceEvents.h"
+
+
+namespace {
+
+/// mixValue spreads a result over the bits used to pick a partition.
+std::uint64_t mixValue(std::uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+/// alignUp rounds a segment offset up to a cache line.
+std::size_t alignUp(std::size_t offset) {
+    const std::size_t CACHE_LINE = 64;
+    return (offset + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+}
+
+/// testJumper revives an inactive JumpPrime object before it is queried,
+/// as DuelingJP does.
+void testJumper(JumpPrime &jumper) {
+    if (!jumper.isActive()) {
+        jumper.revive();
+    }
+}
+
+} // namespace
+
+
+struct ShardedDuelingJP::SharedControl {
+    /// Separates the steps of a round; the workers and the calling process
+    /// all wait on it.
+    pthread_barrier_t roundBarrier;
+
+    /// The command for the round being started.
+    RoundCommand command;
+};
+
+
+void ShardedDuelingJP::prepareShards(int size, int workers) {
+    listSize = std::max(size, 0);
+    shardCount = std::max(1, std::min(workers, std::max(listSize, 1)));
+    workerIds = nullptr;
+
+    // segment layout: control, jumpers, results, exchange, partition starts
+    std::size_t jumpersOffset = alignUp(sizeof(SharedControl));
+    std::size_t resultsOffset = alignUp(jumpersOffset + sizeof(JumpPrime) * listSize);
+    std::size_t exchangeOffset = alignUp(resultsOffset + sizeof(ShardResult) * shardCount);
+    std::size_t startsOffset = alignUp(exchangeOffset +
+                                       sizeof(ExchangeEntry) * 2 * listSize);
+    segmentLength = startsOffset +
+                    sizeof(int) * shardCount * 2 * (shardCount + 1);
+
+    segmentBase = MAP_FAILED;
+    static std::atomic<int> segmentNumber{0};
+    std::string segmentName = "/jumpprime-shard-" + std::to_string(getpid()) +
+                              "-" + std::to_string(segmentNumber++);
+
+    int segmentFd = shm_open(segmentName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (segmentFd >= 0) {
+        // the workers inherit the mapping, so the name is not needed again
+        shm_unlink(segmentName.c_str());
+
+        if (ftruncate(segmentFd, static_cast<off_t>(segmentLength)) == 0) {
+            segmentBase = mmap(nullptr, segmentLength, PROT_READ | PROT_WRITE,
+                               MAP_SHARED, segmentFd, 0);
+        }
+        close(segmentFd);
+    }
+
+    if (segmentBase == MAP_FAILED) {
+        segmentBase = mmap(nullptr, segmentLength, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    }
+
+    segmentShared = (segmentBase != MAP_FAILED);
+    if (!segmentShared) {
+        segmentBase = ::operator new(segmentLength);
+    }
+
+    char *segmentBytes = static_cast<char *>(segmentBase);
+    control = new(segmentBytes) SharedControl;
+    jumperList = reinterpret_cast<JumpPrime *>(segmentBytes + jumpersOffset);
+    shardResults = reinterpret_cast<ShardResult *>(segmentBytes + resultsOffset);
+    exchange = reinterpret_cast<ExchangeEntry *>(segmentBytes + exchangeOffset);
+    partitionStarts = reinterpret_cast<int *>(segmentBytes + startsOffset);
+}
+
+bool ShardedDuelingJP::startWorkers() {
+    if (!segmentShared) {
+        return false;
+    }
+
+    pthread_barrierattr_t barrierAttributes;
+    pthread_barrierattr_init(&barrierAttributes);
+    pthread_barrierattr_setpshared(&barrierAttributes, PTHREAD_PROCESS_SHARED);
+    int barrierResult = pthread_barrier_init(&control->roundBarrier,
+                                             &barrierAttributes,
+                                             shardCount + 1);
+    pthread_barrierattr_destroy(&barrierAttributes);
+    if (barrierResult != 0) {
+        return false;
+    }
+
+    pid_t parentId = getpid();
+    workerIds = new pid_t[shardCount];
+
+    for (int shard = 0; shard < shardCount; shard++) {
+        pid_t workerId = fork();
+
+        if (workerId == 0) {
+            // exit with the creating process instead of waiting forever
+            prctl(PR_SET_PDEATHSIG, SIGKILL);
+            if (getppid() != parentId) {
+                _exit(0);
+            }
+            workerLoop(shard);
+        }
+
+        if (workerId < 0) {
+            // the started workers wait on a barrier that can no longer
+            // fill, so they are killed rather than told to quit
+            for (int i = 0; i < shard; i++) {
+                kill(workerIds[i], SIGKILL);
+                waitpid(workerIds[i], nullptr, 0);
+            }
+            pthread_barrier_destroy(&control->roundBarrier);
+            delete[] workerIds;
+            workerIds = nullptr;
+            return false;
+        }
+
+        workerIds[shard] = workerId;
+    }
+
+    return true;
+}
+
+void ShardedDuelingJP::stopWorkers() {
+    if (workerIds == nullptr) {
+        return;
+    }
+
+    control->command = Quit;
+    pthread_barrier_wait(&control->roundBarrier);
+
+    for (int shard = 0; shard < shardCount; shard++) {
+        waitpid(workerIds[shard], nullptr, 0);
+    }
+
+    pthread_barrier_destroy(&control->roundBarrier);
+    delete[] workerIds;
+    workerIds = nullptr;
+}
+
+void ShardedDuelingJP::workerLoop(int shard) {
+    while (true) {
+        pthread_barrier_wait(&control->roundBarrier);
+
+        RoundCommand command = control->command;
+        if (command == Quit) {
+            _exit(0);
+        }
+
+        queryShard(command, shard);
+        pthread_barrier_wait(&control->roundBarrier);
+
+        aggregatePartition(command, shard);
+        pthread_barrier_wait(&control->roundBarrier);
+    }
+}
+
+int ShardedDuelingJP::sliceBegin(int shard) const {
+    return static_cast<int>(static_cast<long long>(listSize) * shard / shardCount);
+}
+
+int ShardedDuelingJP::partitionOf(unsigned int value) const {
+    return static_cast<int>(mixValue(value) % static_cast<std::uint64_t>(shardCount));
+}
+
+int &ShardedDuelingJP::partitionStart(int shard, int side, int partition) const {
+    return partitionStarts[(shard * 2 + side) * (shardCount + 1) + partition];
+}
+
+void ShardedDuelingJP::queryShard(RoundCommand command, int shard) {
+    int begin = sliceBegin(shard);
+    int end = sliceBegin(shard + 1);
+    int sliceSize = end - begin;
+    bool inversions = (command == Inversions);
+
+    ShardResult &result = shardResults[shard];
+    result.lastZeroPosition = -1;
+
+    // the slice's results, before they are bucketed by partition
+    ExchangeEntry *sideResults[2] = {new ExchangeEntry[sliceSize],
+                                     new ExchangeEntry[inversions ? sliceSize : 0]};
+    int sideCounts[2] = {0, 0};
+
+    for (int i = begin; i < end; i++) {
+        JumpPrime &jumper = jumperList[i];
+
+        if (inversions) {
+            // In case the JumpPrime was inactive
+            testJumper(jumper);
+            sideResults[0][sideCounts[0]++] = ExchangeEntry{jumper.up(), i};
+
+            // In case the up jump deactivated it
+            testJumper(jumper);
+            sideResults[1][sideCounts[1]++] = ExchangeEntry{jumper.down(), i};
+        } else {
+            testJumper(jumper);
+            unsigned int outputValue = (command == CollisionsUp) ?
+                    jumper.up() :
+                    jumper.down();
+
+            // 0 results are accounted for by position alone
+            if (outputValue == 0) {
+                result.lastZeroPosition = i;
+            } else {
+                sideResults[0][sideCounts[0]++] = ExchangeEntry{outputValue, i};
+            }
+        }
+    }
+
+    // counting sort of each side into this shard's part of the exchange
+    for (int side = 0; side < 2; side++) {
+        std::fill(&partitionStart(shard, side, 0),
+                  &partitionStart(shard, side, shardCount) + 1, 0);
+
+        for (int i = 0; i < sideCounts[side]; i++) {
+            partitionStart(shard, side, partitionOf(sideResults[side][i].value) + 1)++;
+        }
+
+        partitionStart(shard, side, 0) = side * listSize + begin;
+        for (int partition = 1; partition <= shardCount; partition++) {
+            partitionStart(shard, side, partition) +=
+                    partitionStart(shard, side, partition - 1);
+        }
+
+        int *nextEntry = new int[shardCount];
+        std::copy(&partitionStart(shard, side, 0),
+                  &partitionStart(shard, side, shardCount), nextEntry);
+
+        for (int i = 0; i < sideCounts[side]; i++) {
+            int partition = partitionOf(sideResults[side][i].value);
+            exchange[nextEntry[partition]++] = sideResults[side][i];
+        }
+
+        delete[] nextEntry;
+        delete[] sideResults[side];
+    }
+}
+
+void ShardedDuelingJP::aggregatePartition(RoundCommand command, int partition) {
+    ShardResult &result = shardResults[partition];
+    result.distinctValues = 0;
+    result.latestFirstPosition = -1;
+    result.inversions = 0;
+
+    if (command == Inversions) {
+        /// For each value, the number of up() and down() results
+        struct InversionCounter {
+            long long upCount = 0;
+            long long downCount = 0;
+        };
+
+        std::unordered_map<unsigned int, InversionCounter> valueCounts;
+
+        for (int shard = 0; shard < shardCount; shard++) {
+            for (int i = partitionStart(shard, 0, partition);
+                 i < partitionStart(shard, 0, partition + 1); i++) {
+                valueCounts[exchange[i].value].upCount++;
+            }
+            for (int i = partitionStart(shard, 1, partition);
+                 i < partitionStart(shard, 1, partition + 1); i++) {
+                valueCounts[exchange[i].value].downCount++;
+            }
+        }
+
+        for (const auto &entry : valueCounts) {
+            result.inversions += entry.second.upCount * entry.second.downCount;
+        }
+    } else {
+        /// For each distinct value, the first position returning it
+        std::unordered_map<unsigned int, int> firstPositions;
+
+        for (int shard = 0; shard < shardCount; shard++) {
+            for (int i = partitionStart(shard, 0, partition);
+                 i < partitionStart(shard, 0, partition + 1); i++) {
+                // shards are visited in position order, so the first
+                // insertion of a value is its first position
+                firstPositions.emplace(exchange[i].value, exchange[i].position);
+            }
+        }
+
+        result.distinctValues = static_cast<long long>(firstPositions.size());
+        for (const auto &entry : firstPositions) {
+            result.latestFirstPosition = std::max<long long>(
+                    result.latestFirstPosition, entry.second);
+        }
+    }
+}
+
+void ShardedDuelingJP::runRound(RoundCommand command) {
+    if (workerIds != nullptr) {
+        control->command = command;
+
+        // start, then wait for the query step and the aggregate step
+        pthread_barrier_wait(&control->roundBarrier);
+        pthread_barrier_wait(&control->roundBarrier);
+        pthread_barrier_wait(&control->roundBarrier);
+    } else {
+        for (int shard = 0; shard < shardCount; shard++) {
+            queryShard(command, shard);
+        }
+        for (int partition = 0; partition < shardCount; partition++) {
+            aggregatePartition(command, partition);
+        }
+    }
+}
+
+
+// assumption: all values in initValues are valid
+ShardedDuelingJP::ShardedDuelingJP(const int *initValues, int size,
+                                   int workers) {
+    prepareShards(size, workers);
+
+    for (int i = 0; i < listSize; i++) {
+        new(&jumperList[i]) JumpPrime(initValues[i]);
+    }
+
+    startWorkers();
+}
+
+ShardedDuelingJP::ShardedDuelingJP(const DuelingJP &sourceObject, int workers) {
+    prepareShards(sourceObject.listSize, workers);
+
+    std::uninitialized_copy(sourceObject.jumperList,
+                            sourceObject.jumperList + listSize, jumperList);
+
+    startWorkers();
+}
+
+ShardedDuelingJP::~ShardedDuelingJP() {
+    stopWorkers();
+
+    if (segmentShared) {
+        munmap(segmentBase, segmentLength);
+    } else {
+        ::operator delete(segmentBase);
+    }
+}
+
+long long ShardedDuelingJP::countCollisions(bool testUp) {
+    JP_COUNT(CollisionPasses);
+    JP_LATENCY_SCOPE(CollisionPass);
+    JP_TRACE_SCOPE(CollisionPass, listSize);
+
+    runRound(testUp ? CollisionsUp : CollisionsDown);
+
+    long long distinctValues = 0;
+    long long latestFirstPosition = -1;
+    long long lastZeroPosition = -1;
+
+    for (int shard = 0; shard < shardCount; shard++) {
+        distinctValues += shardResults[shard].distinctValues;
+        latestFirstPosition = std::max(latestFirstPosition,
+                                       shardResults[shard].latestFirstPosition);
+        lastZeroPosition = std::max(lastZeroPosition,
+                                    shardResults[shard].lastZeroPosition);
+    }
+
+    // the 0 results share one counter, which the next new value takes
+    // over; it only counts if no new value came after the last 0
+    long long zeroCounters = (lastZeroPosition > latestFirstPosition) ? 1 : 0;
+
+    return static_cast<long long>(listSize) - distinctValues - zeroCounters;
+}
+
+long long ShardedDuelingJP::countInversions() {
+    JP_COUNT(InversionPasses);
+    JP_LATENCY_SCOPE(InversionPass);
+    JP_TRACE_SCOPE(InversionPass, listSize);
+
+    runRound(Inversions);
+
+    long long inversionCounter = 0;
+    for (int shard = 0; shard < shardCount; shard++) {
+        inversionCounter += shardResults[shard].inversions;
+    }
+
+    return inversionCounter;
+}
+
+int ShardedDuelingJP::getSize() const {
+    return listSize;
+}
+
+int ShardedDuelingJP::getShardCount() const {
+    return shardCount;
+}
+
+bool ShardedDuelingJP::isMultiProcess() const {
+    return workerIds != nullptr;
+}
@@ -0,0 +1,218 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_SHARDEDDUELINGJP_H
+#define INC_5011_P4_SHARDEDDUELINGJP_H
+
+#include <cstddef>
+#include <sys/types.h>
+#include "JumpPrime.h"
+#include "DuelingJP.h"
+
+
+/*
+ * The ShardedDuelingJP is a DuelingJP whose counting passes run in several
+ * worker processes on one Linux host. The JumpPrime objects live in a POSIX
+ * shared-memory segment; each worker owns a contiguous slice of them and
+ * keeps their state between passes, so no worker ever copies another's
+ * jumpers and each process heap only holds one round's scratch data.
+ *
+ * A counting pass is one round of three steps, separated by a
+ * process-shared barrier:
+ * 1. Every worker queries its slice and writes each result into its part
+ * of the exchange area of the segment, bucketed by a hash of the result
+ * into one partition per worker.
+ * 2. Every worker aggregates one partition from all workers: the distinct
+ * results and, for inversions, the number of up() and down() results of
+ * each value.
+ * 3. The calling process adds up the per-worker partial aggregates.
+ *
+ * METHODS:
+ * 1. The constructor accepts an array of initial values or an existing
+ * DuelingJP object (whose JumpPrime states are copied), and the number of
+ * worker processes to fork.
+ * 2. countCollisions and countInversions return exactly what the same
+ * methods of DuelingJP return for the same JumpPrime objects, and leave
+ * the JumpPrime objects in the same states.
+ *
+ * ASSUMPTIONS:
+ * 1. DuelingJP::countCollisions counts the number of results minus the
+ * number of distinct results, except that a result of 0 (an inactive
+ * JumpPrime object) is replaced by the next new value returned after it.
+ * The workers reproduce this from the last position returning 0 and the
+ * first position returning each other value, so the totals match even
+ * though the slices are queried out of order.
+ * 2. If the segment or the workers cannot be created, the same rounds run
+ * one shard after another in the calling process (see isMultiProcess).
+ * 3. Workers are forked when the object is constructed and stopped when it
+ * is destroyed. They exit if the creating process dies. As with any fork,
+ * the object should be constructed before the process starts other
+ * threads.
+ * 4. Hot-path counters, latency histograms and trace spans of the JumpPrime
+ * objects are recorded by the workers and are not visible to the creating
+ * process; the rounds themselves are recorded as DuelingJP passes.
+ * 5. Counts are returned as long long, as in CompressedDuelingJP.
+ */
+
+/// ShardedDuelingJP runs DuelingJP counting passes in worker processes.
+class ShardedDuelingJP {
+
+    /// RoundCommand tells the workers what to do in the next round.
+    enum RoundCommand : int {
+        CollisionsUp,
+        CollisionsDown,
+        Inversions,
+        Quit
+    };
+
+    /// ShardResult is one worker's partial aggregate of a round.
+    struct ShardResult {
+        /// The number of distinct non-zero results in the worker's
+        /// partition.
+        long long distinctValues;
+
+        /// The greatest first position of a distinct value in the
+        /// partition, or -1.
+        long long latestFirstPosition;
+
+        /// The last position in the worker's slice that returned 0, or -1.
+        long long lastZeroPosition;
+
+        /// The inversions whose value falls in the worker's partition.
+        long long inversions;
+    };
+
+    /// ExchangeEntry is one query result on its way to its partition.
+    struct ExchangeEntry {
+        /// The result.
+        unsigned int value;
+
+        /// The position of the JumpPrime object that returned it.
+        int position;
+    };
+
+    /// SharedControl is the start of the shared segment.
+    struct SharedControl;
+
+    /// The number of shards (worker processes, or in-process shards).
+    int shardCount;
+
+    /// The number of JumpPrime objects.
+    int listSize;
+
+    /// Start and length of the shared segment.
+    void *segmentBase;
+    std::size_t segmentLength;
+
+    /// true if segmentBase is shared memory, false if it is private memory
+    /// from operator new (when no shared memory could be mapped).
+    bool segmentShared;
+
+    /// The parts of the shared segment.
+    SharedControl *control;
+    JumpPrime *jumperList;
+    ShardResult *shardResults;
+    ExchangeEntry *exchange;
+    int *partitionStarts;
+
+    /// The process ids of the running workers; nullptr when the rounds run
+    /// in the calling process.
+    pid_t *workerIds;
+
+    /// prepareShards sets the shard count and maps the segment for a
+    /// number of JumpPrime objects, which the caller then constructs in
+    /// jumperList.
+    /// @param [in] size The number of JumpPrime objects.
+    /// @param [in] workers The requested number of workers.
+    void prepareShards(int size, int workers);
+
+    /// startWorkers forks one worker per shard.
+    /// @return true if every worker started.
+    bool startWorkers();
+
+    /// stopWorkers tells the workers to exit and waits for them.
+    void stopWorkers();
+
+    /// workerLoop runs rounds in a worker until told to quit.
+    /// @param [in] shard The worker's shard number.
+    [[noreturn]] void workerLoop(int shard);
+
+    /// sliceBegin returns the position of the first JumpPrime object of a
+    /// shard; shard shardCount gives listSize.
+    int sliceBegin(int shard) const;
+
+    /// partitionOf returns the partition owning a result.
+    int partitionOf(unsigned int value) const;
+
+    /// partitionStart returns the index of a shard's first exchange entry
+    /// in a partition (partition shardCount gives the end of the shard).
+    /// @param [in] side 0 for up() results, 1 for down() results.
+    int &partitionStart(int shard, int side, int partition) const;
+
+    /// queryShard is step 1 of a round for one shard.
+    void queryShard(RoundCommand command, int shard);
+
+    /// aggregatePartition is step 2 of a round for one partition.
+    void aggregatePartition(RoundCommand command, int partition);
+
+    /// runRound runs a full round and leaves every shard's partial
+    /// aggregate in shardResults.
+    void runRound(RoundCommand command);
+
+public:
+
+    /// The number of workers used when none is given.
+    static constexpr int DEFAULT_WORKERS = 4;
+
+    /// ShardedDuelingJP Constructor creates JumpPrime objects from an array
+    /// of initial values and starts the workers.
+    /// @param [in] initValues Array of initial values for JumpPrime objects
+    /// @param [in] size The size of the array of initial values.
+    /// @param [in] workers The number of worker processes (at least 1 and
+    /// at most size).
+    /// @pre All values of array are valid JumpPrime initial values.
+    ShardedDuelingJP(const int *initValues, int size,
+                     int workers = DEFAULT_WORKERS);
+
+    /// ShardedDuelingJP Constructor copies the JumpPrime objects of a
+    /// DuelingJP object and starts the workers.
+    /// @param [in] sourceObject The DuelingJP object to copy.
+    /// @param [in] workers The number of worker processes.
+    explicit ShardedDuelingJP(const DuelingJP &sourceObject,
+                              int workers = DEFAULT_WORKERS);
+
+    /// ShardedDuelingJP Destructor stops the workers and releases the
+    /// shared segment.
+    ~ShardedDuelingJP();
+
+    ShardedDuelingJP(const ShardedDuelingJP &) = delete;
+    ShardedDuelingJP &operator=(const ShardedDuelingJP &) = delete;
+
+    /// countCollisions runs one collision round across the workers.
+    /// @param [in] testUp If true, tests the JumpPrime objects in the "up"
+    /// direction. Defaults to true.
+    /// @return The number of JumpPrime objects that collided.
+    long long countCollisions(bool testUp = true);
+
+    /// countInversions runs one inversion round across the workers.
+    /// @return The number of JumpPrime object inversions.
+    long long countInversions();
+
+    /// getSize returns the number of JumpPrime objects.
+    /// @return The number of JumpPrime objects.
+    int getSize() const;
+
+    /// getShardCount returns the number of shards.
+    /// @return The number of shards.
+    int getShardCount() const;
+
+    /// isMultiProcess reports whether the rounds run in worker processes.
+    /// @return true if the workers are running, false if the rounds run in
+    /// the calling process.
+    bool isMultiProcess() const;
+
+};
+
+
+#endif //INC_5011_P4_SHARDEDDUELINGJP_H
@@ -0,0 +1,237 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_SORTEDVALUEINDEX_H
+#define INC_5011_P4_SORTEDVALUEINDEX_H
+
+#include <algorithm>
+#include <utility>
+
+
+/*
+ * SortedValueIndex is a read-only sorted index of the encapsulated numbers
+ * of an array of JumpPrime objects, answering range counts and nearest
+ * value lookups in O(log n).
+ *
+ * The numbers are kept in Eytzinger (breadth-first binary tree) order: the
+ * children of position k are 2k and 2k + 1. A search walks down the tree
+ * touching one element per level, and the first levels share a few cache
+ * lines, so lookups miss the cache far less than a binary search over a
+ * sorted array. Each position also records its rank in sorted order, which
+ * turns two searches into a range count, and the number of the JumpPrime
+ * object holding it.
+ *
+ * ASSUMPTIONS:
+ * 1. The index is a copy: it does not change when the JumpPrime objects
+ * do. Its owner calls update after they may have changed (see
+ * DuelingJP.h). update finds the objects whose numbers moved in one O(n)
+ * scan and, if any did, sorts only those and merges them back in, so a
+ * pass in which k objects jumped costs O(n + k log k) rather than a full
+ * O(n log n) rebuild.
+ */
+
+/// SortedValueIndex is an Eytzinger-ordered index of JumpPrime values.
+template <class Value>
+class SortedValueIndex {
+
+    /// The number of indexed values.
+    int indexSize;
+
+    /// The values in Eytzinger order, from position 1 (position 0 unused).
+    Value *keys;
+
+    /// The rank in sorted order of the value at each position.
+    int *ranks;
+
+    /// The number of the JumpPrime object holding the value at each
+    /// position.
+    int *jumperNumbers;
+
+    /// fillPositions places sorted values into the subtree rooted at a
+    /// position, in order.
+    /// @param [in] sortedValues The (value, jumper number) pairs, sorted.
+    /// @param [in] position The root of the subtree to fill.
+    /// @param [in,out] nextRank The rank of the next sorted value to place.
+    void fillPositions(const std::pair<Value, int> *sortedValues,
+                       int position, int &nextRank) {
+        if (position > indexSize) {
+            return;
+        }
+
+        fillPositions(sortedValues, 2 * position, nextRank);
+
+        keys[position] = sortedValues[nextRank].first;
+        jumperNumbers[position] = sortedValues[nextRank].second;
+        ranks[position] = nextRank;
+        nextRank++;
+
+        fillPositions(sortedValues, 2 * position + 1, nextRank);
+    }
+
+    /// findFirst returns the position of the first value that is not less
+    /// than target (or, if orEqual, not less than or equal to it).
+    /// @return The position, or 0 if there is no such value.
+    int findFirst(Value target, bool orEqual) const {
+        int position = 1;
+
+        while (position <= indexSize) {
+            // the values four levels down share a few cache lines
+            __builtin_prefetch(keys + 16 * position);
+
+            bool goRight = orEqual ? !(target < keys[position]) :
+                                     (keys[position] < target);
+            position = 2 * position + (goRight ? 1 : 0);
+        }
+
+        // undo the right turns made after the last left turn
+        return position >> __builtin_ffs(~position);
+    }
+
+    /// rankOf returns the sorted rank of a position found by findFirst.
+    int rankOf(int position) const {
+        return (position == 0) ? indexSize : ranks[position];
+    }
+
+public:
+
+    /// SortedValueIndex Constructor indexes the encapsulated numbers of an
+    /// array of JumpPrime objects.
+    /// @param [in] jumpers The JumpPrime objects to index.
+    /// @param [in] size The number of JumpPrime objects.
+    template <class Jumper>
+    SortedValueIndex(const Jumper *jumpers, int size) {
+        indexSize = size;
+        keys = new Value[size + 1];
+        ranks = new int[size + 1];
+        jumperNumbers = new int[size + 1];
+
+        std::pair<Value, int> *sortedValues = new std::pair<Value, int>[size];
+        for (int i = 0; i < size; i++) {
+            sortedValues[i] = std::make_pair(jumpers[i].getCurrentValue(), i);
+        }
+        std::sort(sortedValues, sortedValues + size);
+
+        int nextRank = 0;
+        fillPositions(sortedValues, 1, nextRank);
+
+        delete[] sortedValues;
+    }
+
+    /// SortedValueIndex Destructor releases the index.
+    ~SortedValueIndex() {
+        delete[] keys;
+        delete[] ranks;
+        delete[] jumperNumbers;
+    }
+
+    SortedValueIndex(const SortedValueIndex &) = delete;
+    SortedValueIndex &operator=(const SortedValueIndex &) = delete;
+
+    /// countInRange counts the values in a closed range.
+    /// @param [in] low The smallest value counted.
+    /// @param [in] high The largest value counted.
+    /// @return The number of values v with low <= v <= high.
+    int countInRange(Value low, Value high) const {
+        if (high < low) {
+            return 0;
+        }
+
+        return rankOf(findFirst(high, true)) - rankOf(findFirst(low, false));
+    }
+
+    /// nearest finds the value closest to a target, preferring the smaller
+    /// value when two are equally close.
+    /// @param [in] target The value to look near.
+    /// @return The number of a JumpPrime object holding the closest value,
+    /// or -1 if the index is empty.
+    int nearest(Value target) const {
+        if (indexSize == 0) {
+            return -1;
+        }
+
+        // one descent finds both the greatest value below target and the
+        // smallest value not below it
+        int below = 0;
+        int above = 0;
+        int position = 1;
+        while (position <= indexSize) {
+            if (keys[position] < target) {
+                below = position;
+                position = 2 * position + 1;
+            } else {
+                above = position;
+                position = 2 * position;
+            }
+        }
+
+        if (above == 0) {
+            return jumperNumbers[below];
+        }
+        if ((below != 0) && (target - keys[below] <= keys[above] - target)) {
+            return jumperNumbers[below];
+        }
+
+        return jumperNumbers[above];
+    }
+
+    /// update brings the index up to date with the JumpPrime objects it
+    /// was built from, which must be the same number of objects.
+    /// @param [in] jumpers The JumpPrime objects, possibly changed.
+    /// @return The number of JumpPrime objects whose number had moved.
+    template <class Jumper>
+    int update(const Jumper *jumpers) {
+        int movedCount = 0;
+        for (int position = 1; position <= indexSize; position++) {
+            if (!(jumpers[jumperNumbers[position]].getCurrentValue() == keys[position])) {
+                movedCount++;
+            }
+        }
+        if (movedCount == 0) {
+            return 0;
+        }
+
+        // the unmoved values in sorted order, then the moved ones
+        std::pair<Value, int> *sortedValues = new std::pair<Value, int>[indexSize];
+        for (int position = 1; position <= indexSize; position++) {
+            sortedValues[ranks[position]] =
+                    std::make_pair(keys[position], jumperNumbers[position]);
+        }
+
+        int keptCount = 0;
+        std::pair<Value, int> *movedValues = new std::pair<Value, int>[movedCount];
+        int nextMoved = 0;
+        for (int rank = 0; rank < indexSize; rank++) {
+            const Jumper &jumper = jumpers[sortedValues[rank].second];
+            if (jumper.getCurrentValue() == sortedValues[rank].first) {
+                sortedValues[keptCount++] = sortedValues[rank];
+            } else {
+                movedValues[nextMoved++] =
+                        std::make_pair(jumper.getCurrentValue(), sortedValues[rank].second);
+            }
+        }
+
+        std::sort(movedValues, movedValues + movedCount);
+        std::copy(movedValues, movedValues + movedCount, sortedValues + keptCount);
+        std::inplace_merge(sortedValues, sortedValues + keptCount,
+                           sortedValues + indexSize);
+
+        int nextRank = 0;
+        fillPositions(sortedValues, 1, nextRank);
+
+        delete[] movedValues;
+        delete[] sortedValues;
+
+        return movedCount;
+    }
+
+    /// getSize returns the number of indexed values.
+    /// @return The number of values.
+    int getSize() const {
+        return indexSize;
+    }
+
+};
+
+
+#endif //INC_5011_P4_SORTEDVALUEINDEX_H
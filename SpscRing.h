@@ -0,0 +1,138 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_SPSCRING_H
+#define INC_5011_P4_SPSCRING_H
+
+#include <atomic>
+#include <cstdint>
+
+
+/*
+ * SpscRing is a bounded lock-free queue between exactly one producer
+ * thread and one consumer thread.
+ *
+ * Items are filled and read in place, so large items (batches of values)
+ * are never copied through the queue: the producer claims the next free
+ * slot, fills it and publishes it; the consumer reads the oldest published
+ * slot and releases it. Each side owns one position counter and only reads
+ * the other's, so a push or pop is one acquire load and one release store
+ * with no read-modify-write. Each side also keeps a cached copy of the
+ * other's position and reloads it only when the ring looks full (or
+ * empty), so the two cores rarely touch the same cache line.
+ *
+ * A full ring is the producer's backpressure: claimSlot returns nullptr
+ * and the producer waits (or does other work) until the consumer catches
+ * up. close marks the end of the stream; the consumer sees isDrained once
+ * it has read everything published before close.
+ *
+ * ASSUMPTIONS:
+ * 1. claimSlot, publish and close are only called by the producer, and
+ * frontSlot, release and isDrained only by the consumer.
+ * 2. Item is default constructible; the ring constructs capacity items up
+ * front and reuses them.
+ */
+
+/// SpscRing is a bounded single-producer single-consumer queue.
+template <class Item>
+class SpscRing {
+
+    /// The slots; capacity is a power of two.
+    Item *slots;
+    std::uint64_t capacity;
+
+    /// The producer's next position, and its copy of releasePosition.
+    alignas(64) std::atomic<std::uint64_t> publishPosition;
+    std::uint64_t cachedRelease;
+
+    /// The consumer's next position, and its copy of publishPosition.
+    alignas(64) std::atomic<std::uint64_t> releasePosition;
+    std::uint64_t cachedPublish;
+
+    /// Set by the producer after its last publish.
+    alignas(64) std::atomic<bool> closed;
+
+public:
+
+    /// SpscRing Constructor creates an empty ring.
+    /// @param [in] slotCount The most items queued at once; rounded up to
+    /// a power of two.
+    explicit SpscRing(int slotCount) {
+        capacity = 1;
+        while (capacity < static_cast<std::uint64_t>(slotCount)) {
+            capacity <<= 1;
+        }
+        slots = new Item[capacity];
+        publishPosition.store(0, std::memory_order_relaxed);
+        releasePosition.store(0, std::memory_order_relaxed);
+        cachedRelease = 0;
+        cachedPublish = 0;
+        closed.store(false, std::memory_order_relaxed);
+    }
+
+    /// SpscRing Destructor frees the slots.
+    ~SpscRing() {
+        delete[] slots;
+    }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    /// claimSlot returns the next free slot for the producer to fill.
+    /// @return The slot, or nullptr if the ring is full.
+    Item *claimSlot() {
+        std::uint64_t position = publishPosition.load(std::memory_order_relaxed);
+        if (position - cachedRelease >= capacity) {
+            cachedRelease = releasePosition.load(std::memory_order_acquire);
+            if (position - cachedRelease >= capacity) {
+                return nullptr;
+            }
+        }
+        return &slots[position & (capacity - 1)];
+    }
+
+    /// publish hands the slot returned by claimSlot to the consumer.
+    void publish() {
+        publishPosition.store(publishPosition.load(std::memory_order_relaxed) + 1,
+                              std::memory_order_release);
+    }
+
+    /// close tells the consumer that nothing more will be published.
+    void close() {
+        closed.store(true, std::memory_order_release);
+    }
+
+    /// frontSlot returns the oldest published slot for the consumer.
+    /// @return The slot, or nullptr if the ring is empty.
+    Item *frontSlot() {
+        std::uint64_t position = releasePosition.load(std::memory_order_relaxed);
+        if (position == cachedPublish) {
+            cachedPublish = publishPosition.load(std::memory_order_acquire);
+            if (position == cachedPublish) {
+                return nullptr;
+            }
+        }
+        return &slots[position & (capacity - 1)];
+    }
+
+    /// release returns the slot returned by frontSlot to the producer.
+    void release() {
+        releasePosition.store(releasePosition.load(std::memory_order_relaxed) + 1,
+                              std::memory_order_release);
+    }
+
+    /// isDrained reports whether the producer has closed the ring and the
+    /// consumer has read everything it published.
+    bool isDrained() {
+        // read closed first: a publish before close is then visible below
+        if (!closed.load(std::memory_order_acquire)) {
+            return false;
+        }
+        return frontSlot() == nullptr;
+    }
+
+};
+
+
+#endif //INC_5011_P4_SPSCRING_H
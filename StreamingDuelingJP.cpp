@@ -0,0 +1,303 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <future>
+#include <unordered_map>
+#include "DuelingJP.h"
+#include "StreamingDuelingJP.h"
+
+
+namespace {
+
+/// Approximate bytes used per seed of a chunk: two read buffers, the
+/// JumpPrime object and its up() and down() results.
+const std::size_t BYTES_PER_SEED =
+        2 * sizeof(int) + sizeof(JumpPrime) + 2 * sizeof(unsigned int);
+
+/// Approximate bytes used per entry of an unordered_map aggregate.
+const std::size_t BYTES_PER_ENTRY = 64;
+
+const std::size_t MIN_CHUNK_SEEDS = 1024;
+const std::size_t MIN_AGGREGATE_ENTRIES = 1024;
+
+/// ValueCounter is the number of JumpPrime objects that returned a value
+/// from up() and from down().
+struct ValueCounter {
+    long long upCount = 0;
+    long long downCount = 0;
+};
+
+/// SpillRecord is the on-disk form of one aggregate entry.
+struct SpillRecord {
+    unsigned int value;
+    long long upCount;
+    long long downCount;
+};
+
+/// AggregateTotals are the counts that follow from a complete aggregate.
+struct AggregateTotals {
+    long long distinctUp = 0;
+    long long distinctDown = 0;
+    long long inversions = 0;
+};
+
+/// SpillableAggregate counts output values in a hash table of bounded size.
+/// When the table is full it is written out to partition files (by value
+/// hash) and cleared; finish() merges each partition back on its own.
+class SpillableAggregate {
+
+    typedef std::unordered_map<unsigned int, ValueCounter> CounterMap;
+
+    CounterMap counters;
+    std::size_t maxEntries;
+
+    int partitionCount;
+    std::FILE **partitionFiles;
+
+    int spillCount;
+    bool spillFailed;
+
+    int partitionOf(unsigned int value) const {
+        // multiplicative hash so clustered primes spread over partitions
+        return static_cast<int>(
+                ((static_cast<std::uint64_t>(value) * 0x9E3779B97F4A7C15ull) >> 32)
+                % static_cast<std::uint64_t>(partitionCount));
+    }
+
+    static void addTotals(const CounterMap &counterMap, AggregateTotals &totals) {
+        for (const auto &entry : counterMap) {
+            if (entry.second.upCount > 0) {
+                totals.distinctUp++;
+            }
+            if (entry.second.downCount > 0) {
+                totals.distinctDown++;
+            }
+            totals.inversions += entry.second.upCount * entry.second.downCount;
+        }
+    }
+
+    void spill() {
+        if (partitionFiles == nullptr) {
+            partitionFiles = new std::FILE *[partitionCount];
+            for (int p = 0; p < partitionCount; p++) {
+                partitionFiles[p] = std::tmpfile();
+                if (partitionFiles[p] == nullptr) {
+                    spillFailed = true;
+                }
+            }
+        }
+
+        for (const auto &entry : counters) {
+            std::FILE *partitionFile = partitionFiles[partitionOf(entry.first)];
+            SpillRecord record = {entry.first,
+                                  entry.second.upCount,
+                                  entry.second.downCount};
+            if ((partitionFile == nullptr) ||
+                (std::fwrite(&record, sizeof(record), 1, partitionFile) != 1)) {
+                spillFailed = true;
+            }
+        }
+
+        counters.clear();
+        spillCount++;
+    }
+
+public:
+
+    SpillableAggregate(std::size_t entryLimit, int partitions)
+            : maxEntries(entryLimit), partitionCount(std::max(1, partitions)),
+              partitionFiles(nullptr), spillCount(0), spillFailed(false) {
+        counters.reserve(entryLimit);
+    }
+
+    ~SpillableAggregate() {
+        if (partitionFiles != nullptr) {
+            for (int p = 0; p < partitionCount; p++) {
+                if (partitionFiles[p] != nullptr) {
+                    std::fclose(partitionFiles[p]);
+                }
+            }
+            delete[] partitionFiles;
+        }
+    }
+
+    SpillableAggregate(const SpillableAggregate &) = delete;
+    SpillableAggregate &operator=(const SpillableAggregate &) = delete;
+
+    void add(const unsigned int *upOutputs, const unsigned int *downOutputs,
+             std::size_t count) {
+        for (std::size_t i = 0; i < count; i++) {
+            if (counters.size() >= maxEntries) {
+                spill();
+            }
+            counters[upOutputs[i]].upCount++;
+
+            if (counters.size() >= maxEntries) {
+                spill();
+            }
+            counters[downOutputs[i]].downCount++;
+        }
+    }
+
+    /// finish merges everything added so far.
+    /// @return false if a spill file could not be written or read.
+    bool finish(AggregateTotals &totals) {
+        if (partitionFiles == nullptr) {
+            addTotals(counters, totals);
+            return true;
+        }
+
+        spill();
+
+        CounterMap partitionCounters;
+        for (int p = 0; p < partitionCount; p++) {
+            std::FILE *partitionFile = partitionFiles[p];
+            if (partitionFile == nullptr) {
+                continue;
+            }
+            std::rewind(partitionFile);
+
+            SpillRecord record;
+            while (std::fread(&record, sizeof(record), 1, partitionFile) == 1) {
+                ValueCounter &counter = partitionCounters[record.value];
+                counter.upCount += record.upCount;
+                counter.downCount += record.downCount;
+            }
+            if (std::ferror(partitionFile)) {
+                spillFailed = true;
+            }
+
+            addTotals(partitionCounters, totals);
+            partitionCounters.clear();
+        }
+
+        return !spillFailed;
+    }
+
+    int getSpillCount() const {
+        return spillCount;
+    }
+};
+
+/// readChunk reads up to maxSeeds seeds into buffer.
+/// @return The number of bytes read; fewer than maxSeeds seeds only at the
+/// end of the file, and not a whole number of seeds if it ends mid-seed.
+std::size_t readChunk(std::FILE *seedFile, int *buffer, std::size_t maxSeeds) {
+    return std::fread(buffer, 1, maxSeeds * sizeof(int), seedFile);
+}
+
+} // namespace
+
+
+StreamingDuelingJP::StreamingDuelingJP(const StreamConfig &streamConfig)
+        : config(streamConfig) {
+
+    // half of the cap goes to the chunk being evaluated, half to the
+    // aggregate
+    std::size_t halfCap = config.memoryCapBytes / 2;
+
+    chunkSeeds = std::max(MIN_CHUNK_SEEDS, halfCap / BYTES_PER_SEED);
+    aggregateEntries = std::max(MIN_AGGREGATE_ENTRIES, halfCap / BYTES_PER_ENTRY);
+}
+
+bool StreamingDuelingJP::evaluate(const char *seedPath, StreamReport &report) {
+
+    report = StreamReport();
+    report.chunkSeeds = chunkSeeds;
+
+    std::FILE *seedFile = std::fopen(seedPath, "rb");
+    if (seedFile == nullptr) {
+        return false;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    int *readBuffers[2] = {new int[chunkSeeds], new int[chunkSeeds]};
+    unsigned int *upOutputs = new unsigned int[chunkSeeds];
+    unsigned int *downOutputs = new unsigned int[chunkSeeds];
+
+    SpillableAggregate aggregate(aggregateEntries, config.spillPartitions);
+
+    // read the first chunk, then always have the next one in flight while
+    // the current one is evaluated
+    int current = 0;
+    std::size_t currentBytes = readChunk(seedFile, readBuffers[current], chunkSeeds);
+    std::size_t currentCount = currentBytes / sizeof(int);
+
+    while (currentCount > 0) {
+        int next = 1 - current;
+        std::future<std::size_t> nextRead;
+        if (currentCount == chunkSeeds) {
+            nextRead = std::async(std::launch::async, readChunk, seedFile,
+                                  readBuffers[next], chunkSeeds);
+        }
+
+        {
+            DuelingJP chunkDJP(readBuffers[current],
+                               static_cast<int>(currentCount));
+            chunkDJP.queryInversionOutputs(upOutputs, downOutputs);
+        }
+        aggregate.add(upOutputs, downOutputs, currentCount);
+
+        report.seedCount += static_cast<long long>(currentCount);
+        report.chunkCount++;
+
+        // a short chunk is the last one
+        report.trailingBytes = static_cast<int>(currentBytes % sizeof(int));
+        currentBytes = nextRead.valid() ? nextRead.get() : 0;
+        currentCount = currentBytes / sizeof(int);
+        current = next;
+    }
+    if (currentBytes % sizeof(int) != 0) {
+        report.trailingBytes = static_cast<int>(currentBytes % sizeof(int));
+    }
+
+    // a partial seed at the end means the file is not a seed file
+    bool readOk = !std::ferror(seedFile) && (report.trailingBytes == 0);
+    std::fclose(seedFile);
+
+    AggregateTotals totals;
+    bool aggregateOk = aggregate.finish(totals);
+
+    report.upCollisions = report.seedCount - totals.distinctUp;
+    report.downCollisions = report.seedCount - totals.distinctDown;
+    report.inversions = totals.inversions;
+    report.spillCount = aggregate.getSpillCount();
+
+    std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - startTime;
+    report.elapsedSeconds = elapsed.count();
+    report.seedsPerSecond = (report.elapsedSeconds > 0.0) ?
+            static_cast<double>(report.seedCount) / report.elapsedSeconds : 0.0;
+
+    delete[] readBuffers[0];
+    delete[] readBuffers[1];
+    delete[] upOutputs;
+    delete[] downOutputs;
+
+    return readOk && aggregateOk;
+}
+
+std::size_t StreamingDuelingJP::getChunkSeeds() const {
+    return chunkSeeds;
+}
+
+void printStreamReport(const StreamReport &report, std::ostream &output) {
+    output << "Seeds evaluated: " << report.seedCount << "\n";
+    output << "Chunks: " << report.chunkCount
+           << " (" << report.chunkSeeds << " seeds per chunk)\n";
+    output << "Aggregate spills: " << report.spillCount << "\n";
+    if (report.trailingBytes != 0) {
+        output << "Trailing bytes not evaluated: " << report.trailingBytes << "\n";
+    }
+    output << "Up collisions: " << report.upCollisions << "\n";
+    output << "Down collisions: " << report.downCollisions << "\n";
+    output << "Inversions: " << report.inversions << "\n";
+    output << "Elapsed seconds: " << report.elapsedSeconds << "\n";
+    output << "Throughput (seeds/s): " << report.seedsPerSecond << "\n";
+}
@@ -0,0 +1,115 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_STREAMINGDUELINGJP_H
+#define INC_5011_P4_STREAMINGDUELINGJP_H
+
+#include <cstddef>
+#include <ostream>
+
+
+/*
+ * The StreamingDuelingJP evaluates a population of JumpPrime objects that is
+ * too large to hold in memory. The initial values are read from a binary
+ * file of 32-bit integers (native byte order) in fixed-size chunks. Each
+ * chunk is built into a DuelingJP object and queried once, as by
+ * countInversions (up() then down() on every JumpPrime object). The results
+ * of every chunk are merged into a single hash aggregate that counts, for
+ * each output value, how many JumpPrime objects returned it from up() and
+ * from down(). When the aggregate outgrows its share of the memory cap it
+ * is spilled to temporary partition files and merged again at the end.
+ *
+ * The counts reported are those a single DuelingJP object holding the
+ * whole file would report for one inversion pass:
+ * - up collisions: JumpPrime objects whose up() result was already returned
+ * by another JumpPrime object's up() call
+ * - down collisions: the same for down()
+ * - inversions: (up, down) pairs of JumpPrime objects returning the same value
+ *
+ * ASSUMPTIONS:
+ * 1. All values in the file are valid JumpPrime initial values, and the
+ * file length is a multiple of the seed size.
+ * 2. The next chunk is read on a background thread while the current chunk
+ * is evaluated (double buffering), so two chunk buffers are live at once.
+ * 3. The memory cap bounds the chunk buffers, the DuelingJP object of a
+ * chunk and the in-memory aggregate. Each spill partition is merged on its
+ * own; with very many distinct output values a partition may exceed its
+ * share of the cap.
+ */
+
+/// StreamConfig holds the limits used by StreamingDuelingJP.
+struct StreamConfig {
+    /// Approximate upper bound on the memory used during evaluation.
+    std::size_t memoryCapBytes = 64u << 20;
+
+    /// The number of temporary files a spilled aggregate is split into.
+    int spillPartitions = 64;
+};
+
+/// StreamReport holds the results of one StreamingDuelingJP evaluation.
+struct StreamReport {
+    long long seedCount = 0;
+    long long upCollisions = 0;
+    long long downCollisions = 0;
+    long long inversions = 0;
+
+    /// The number of chunks read from the file.
+    int chunkCount = 0;
+
+    /// The number of seeds per chunk.
+    std::size_t chunkSeeds = 0;
+
+    /// The number of times the aggregate was spilled to disk.
+    int spillCount = 0;
+
+    /// The bytes at the end of the file that do not make up a whole seed
+    /// (0 for a well-formed file). They are not evaluated.
+    int trailingBytes = 0;
+
+    double elapsedSeconds = 0.0;
+    double seedsPerSecond = 0.0;
+};
+
+/// StreamingDuelingJP evaluates seed files larger than memory one chunk at
+/// a time within a fixed memory cap.
+class StreamingDuelingJP {
+
+    StreamConfig config;
+
+    /// The number of seeds read per chunk, derived from the memory cap.
+    std::size_t chunkSeeds;
+
+    /// The number of aggregate entries held in memory before spilling.
+    std::size_t aggregateEntries;
+
+public:
+
+    /// StreamingDuelingJP Constructor sizes the chunk buffers and the
+    /// aggregate from the memory cap.
+    /// @param [in] streamConfig The memory cap and spill settings.
+    explicit StreamingDuelingJP(const StreamConfig &streamConfig = StreamConfig());
+
+    /// evaluate streams a seed file through DuelingJP objects, one chunk
+    /// at a time.
+    /// @param [in] seedPath Path of a binary file of 32-bit seeds.
+    /// @param [out] report The counts and throughput of the evaluation.
+    /// @return true if the file was read completely, false on an I/O error
+    /// (report then holds the counts of the chunks read so far) or if the
+    /// file ends with a partial seed (report.trailingBytes is then set and
+    /// the counts cover every whole seed).
+    bool evaluate(const char *seedPath, StreamReport &report);
+
+    /// getChunkSeeds returns the number of seeds read per chunk.
+    /// @return The chunk size in seeds.
+    std::size_t getChunkSeeds() const;
+
+};
+
+/// printStreamReport writes a StreamReport in human readable form.
+/// @param [in] report The report to print.
+/// @param [in] output The stream to print to.
+void printStreamReport(const StreamReport &report, std::ostream &output);
+
+
+#endif //INC_5011_P4_STREAMINGDUELINGJP_H
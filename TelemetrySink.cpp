@@ -0,0 +1,276 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include "TelemetrySink.h"
+
+static_assert(sizeof(TelemetryRecord) == 40,
+              "TelemetryRecord layout changed: update the binary format version");
+
+
+namespace {
+
+const char TELEMETRY_MAGIC[8] = {'J', 'P', 'T', 'E', 'L', 'E', 'M', '\0'};
+const std::uint32_t TELEMETRY_FORMAT_VERSION = 1;
+
+/// The longest CSV line of a record.
+const int CSV_LINE_BYTES = 128;
+
+/// Empty polls of the queue (about 200 us apart) before a partly filled
+/// buffer is written anyway.
+const int IDLE_POLLS_BEFORE_FLUSH = 25;
+
+const char *operationName(std::uint32_t operation) {
+    switch (static_cast<TelemetryOperation>(operation)) {
+        case TelemetryOperation::UpCollisions:
+            return "up_collisions";
+        case TelemetryOperation::DownCollisions:
+            return "down_collisions";
+        case TelemetryOperation::Inversions:
+            return "inversions";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+
+TelemetrySink::TelemetrySink() {
+    cells = nullptr;
+    capacity = 0;
+    enqueuePosition.store(0);
+    dequeuePosition = 0;
+    accepting.store(false);
+    stopRequested.store(false);
+    droppedCount.store(0);
+    writtenCount.store(0);
+    fileDescriptor = -1;
+    fileFormat = TelemetryFormat::Csv;
+    writeFailed = false;
+    buffer = nullptr;
+    bufferUsed = 0;
+}
+
+TelemetrySink::~TelemetrySink() {
+    close();
+}
+
+bool TelemetrySink::open(const std::string &path, TelemetryFormat format,
+                         int queueCapacity) {
+    close();
+
+    fileDescriptor = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fileDescriptor < 0) {
+        return false;
+    }
+
+    capacity = 1;
+    while (capacity < static_cast<std::uint64_t>(queueCapacity)) {
+        capacity <<= 1;
+    }
+    cells = new QueueCell[capacity];
+    for (std::uint64_t i = 0; i < capacity; i++) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    enqueuePosition.store(0, std::memory_order_relaxed);
+    dequeuePosition = 0;
+
+    fileFormat = format;
+    writeFailed = false;
+    buffer = new char[BUFFER_BYTES];
+    bufferUsed = 0;
+    droppedCount.store(0, std::memory_order_relaxed);
+    writtenCount.store(0, std::memory_order_relaxed);
+
+    if (format == TelemetryFormat::Csv) {
+        const char header[] = "time_ns,source,round,operation,count,latency_ns\n";
+        appendBytes(header, sizeof(header) - 1);
+    } else {
+        std::uint32_t layout[2] = {TELEMETRY_FORMAT_VERSION,
+                                   static_cast<std::uint32_t>(sizeof(TelemetryRecord))};
+        appendBytes(TELEMETRY_MAGIC, sizeof(TELEMETRY_MAGIC));
+        appendBytes(reinterpret_cast<const char *>(layout), sizeof(layout));
+    }
+
+    openTime = std::chrono::steady_clock::now();
+    stopRequested.store(false, std::memory_order_relaxed);
+    accepting.store(true, std::memory_order_release);
+    writerThread = std::thread(&TelemetrySink::runWriter, this);
+
+    return true;
+}
+
+bool TelemetrySink::record(std::uint32_t source, std::uint32_t round,
+                           TelemetryOperation operation, std::int64_t count,
+                           std::uint64_t latencyNanoseconds) {
+    if (!accepting.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    // claim the cell at the queue's tail
+    std::uint64_t position = enqueuePosition.load(std::memory_order_relaxed);
+    QueueCell *cell;
+    while (true) {
+        cell = &cells[position & (capacity - 1)];
+        std::uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::int64_t difference = static_cast<std::int64_t>(sequence - position);
+
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1,
+                                                      std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // the writer has not drained this cell yet: the queue is full
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - openTime;
+    cell->record.timeNanoseconds = static_cast<std::uint64_t>(elapsed.count());
+    cell->record.latencyNanoseconds = latencyNanoseconds;
+    cell->record.count = count;
+    cell->record.source = source;
+    cell->record.round = round;
+    cell->record.operation = static_cast<std::uint32_t>(operation);
+    cell->record.reserved = 0;
+
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool TelemetrySink::close() {
+    if (fileDescriptor < 0) {
+        return true;
+    }
+
+    accepting.store(false, std::memory_order_release);
+    stopRequested.store(true, std::memory_order_release);
+    writerThread.join();
+
+    ::close(fileDescriptor);
+    fileDescriptor = -1;
+
+    delete[] cells;
+    cells = nullptr;
+    delete[] buffer;
+    buffer = nullptr;
+
+    return !writeFailed;
+}
+
+bool TelemetrySink::isOpen() const {
+    return accepting.load(std::memory_order_acquire);
+}
+
+std::uint64_t TelemetrySink::getDroppedCount() const {
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t TelemetrySink::getWrittenCount() const {
+    return writtenCount.load(std::memory_order_relaxed);
+}
+
+bool TelemetrySink::tryPop(TelemetryRecord &record) {
+    QueueCell &cell = cells[dequeuePosition & (capacity - 1)];
+    if (cell.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+        return false;
+    }
+
+    record = cell.record;
+
+    // hand the cell to the producer one lap ahead
+    cell.sequence.store(dequeuePosition + capacity, std::memory_order_release);
+    dequeuePosition++;
+    return true;
+}
+
+void TelemetrySink::appendRecord(const TelemetryRecord &record) {
+    if (fileFormat == TelemetryFormat::Binary) {
+        appendBytes(reinterpret_cast<const char *>(&record), sizeof(record));
+        return;
+    }
+
+    char line[CSV_LINE_BYTES];
+    int length = std::snprintf(line, sizeof(line), "%llu,%u,%u,%s,%lld,%llu\n",
+                               static_cast<unsigned long long>(record.timeNanoseconds),
+                               record.source, record.round,
+                               operationName(record.operation),
+                               static_cast<long long>(record.count),
+                               static_cast<unsigned long long>(record.latencyNanoseconds));
+    appendBytes(line, static_cast<std::size_t>(length));
+}
+
+void TelemetrySink::appendBytes(const char *bytes, std::size_t length) {
+    if (bufferUsed + length > BUFFER_BYTES) {
+        flushBuffer();
+    }
+    std::memcpy(buffer + bufferUsed, bytes, length);
+    bufferUsed += length;
+}
+
+void TelemetrySink::flushBuffer() {
+    const char *position = buffer;
+    std::size_t remaining = bufferUsed;
+
+    while (!writeFailed && (remaining > 0)) {
+        ssize_t bytesWritten = ::write(fileDescriptor, position, remaining);
+        if (bytesWritten < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // keep draining so producers never stall, but stop writing
+            writeFailed = true;
+            break;
+        }
+        position += bytesWritten;
+        remaining -= static_cast<std::size_t>(bytesWritten);
+    }
+
+    bufferUsed = 0;
+}
+
+void TelemetrySink::runWriter() {
+    int idlePolls = 0;
+
+    while (true) {
+        std::uint64_t drained = 0;
+        TelemetryRecord record;
+        while (tryPop(record)) {
+            appendRecord(record);
+            drained++;
+        }
+
+        if (drained > 0) {
+            writtenCount.fetch_add(drained, std::memory_order_relaxed);
+            idlePolls = 0;
+            continue;
+        }
+
+        // close() is only called once no producer is mid-record, so an
+        // empty queue after the stop request stays empty
+        if (stopRequested.load(std::memory_order_acquire)) {
+            while (tryPop(record)) {
+                appendRecord(record);
+                writtenCount.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+        }
+
+        idlePolls++;
+        if ((idlePolls == IDLE_POLLS_BEFORE_FLUSH) && (bufferUsed > 0)) {
+            flushBuffer();
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+
+    flushBuffer();
+}
@@ -0,0 +1,203 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_TELEMETRYSINK_H
+#define INC_5011_P4_TELEMETRYSINK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+
+/*
+ * TelemetrySink logs per-round results of simulations (for example the
+ * collision and inversion counts of DuelingJP counting passes) without
+ * making the simulation threads wait for I/O.
+ *
+ * record() copies a fixed-size record into a bounded lock-free queue
+ * (Vyukov's array queue: each cell carries a sequence number, so a
+ * producer claims a cell with one compare-and-swap and publishes it with
+ * one store). A background writer thread drains the queue into a 1 MB
+ * buffer and writes the buffer to the log file when it fills, or when the
+ * queue has been idle for a few milliseconds, so the file sees few large
+ * writes rather than a flush per line.
+ *
+ * FILE FORMATS:
+ * 1. Csv: a header line, then one line per record:
+ *      time_ns,source,round,operation,count,latency_ns
+ * 2. Binary: a 16-byte header (magic "JPTELEM" and a zero byte, format
+ * version 1, record size 40, both 32-bit native order), then each
+ * TelemetryRecord as it is in memory.
+ *
+ * ASSUMPTIONS:
+ * 1. record() may be called from any number of threads at once. It never
+ * blocks: when the queue is full the record is dropped and counted, so a
+ * writer that falls behind loses records rather than slowing the
+ * simulation. Size the queue for the burst expected between drains.
+ * 2. open() and close() are called from one thread, while no thread is in
+ * record(). Records from before open() or after close() are rejected.
+ * 3. Records are written in the order they claimed queue cells, which is
+ * the order of their record() calls up to concurrent calls.
+ */
+
+/// TelemetryOperation names what a telemetry record measured.
+enum class TelemetryOperation : std::uint32_t {
+    UpCollisions,
+    DownCollisions,
+    Inversions
+};
+
+/// TelemetryFormat is the layout of a telemetry log.
+enum class TelemetryFormat {
+    Csv, Binary
+};
+
+/// TelemetryRecord is one entry of a telemetry log.
+struct TelemetryRecord {
+    /// When the record was made, in nanoseconds since the sink opened.
+    std::uint64_t timeNanoseconds;
+
+    /// How long the measured operation took.
+    std::uint64_t latencyNanoseconds;
+
+    /// The operation's result (a collision or inversion count).
+    std::int64_t count;
+
+    /// The thread or shard that made the record.
+    std::uint32_t source;
+
+    /// The round of the simulation.
+    std::uint32_t round;
+
+    /// The measured operation (a TelemetryOperation).
+    std::uint32_t operation;
+
+    /// Zero; pads the record to a multiple of 8 bytes.
+    std::uint32_t reserved;
+};
+
+/// TelemetrySink queues telemetry records and writes them from a
+/// background thread.
+class TelemetrySink {
+
+    /// QueueCell is one slot of the queue, on its own cache line.
+    struct alignas(64) QueueCell {
+        /// The position the cell is ready for: equal to a producer's
+        /// position when free, one past it once filled.
+        std::atomic<std::uint64_t> sequence;
+
+        TelemetryRecord record;
+    };
+
+    /// The queue cells; capacity is a power of two.
+    QueueCell *cells;
+    std::uint64_t capacity;
+
+    /// The next position producers claim.
+    alignas(64) std::atomic<std::uint64_t> enqueuePosition;
+
+    /// The next position the writer drains; only the writer uses it.
+    alignas(64) std::uint64_t dequeuePosition;
+
+    /// true between open() and close().
+    std::atomic<bool> accepting;
+
+    /// Set by close() to stop the writer once the queue is empty.
+    std::atomic<bool> stopRequested;
+
+    /// Counts of records dropped by a full queue and written to the file.
+    std::atomic<std::uint64_t> droppedCount;
+    std::atomic<std::uint64_t> writtenCount;
+
+    /// The log file and its layout.
+    int fileDescriptor;
+    TelemetryFormat fileFormat;
+
+    /// true once a write to the log file has failed.
+    bool writeFailed;
+
+    /// The writer's buffer.
+    char *buffer;
+    std::size_t bufferUsed;
+
+    /// When the sink was opened.
+    std::chrono::steady_clock::time_point openTime;
+
+    std::thread writerThread;
+
+    /// tryPop takes the oldest record off the queue; writer thread only.
+    /// @return false if the queue is empty.
+    bool tryPop(TelemetryRecord &record);
+
+    /// appendRecord adds a record to the buffer, flushing it if full.
+    void appendRecord(const TelemetryRecord &record);
+
+    /// appendBytes adds bytes to the buffer, flushing it if full.
+    void appendBytes(const char *bytes, std::size_t length);
+
+    /// flushBuffer writes the buffer to the log file.
+    void flushBuffer();
+
+    /// runWriter drains the queue until close() is called.
+    void runWriter();
+
+public:
+
+    /// The queue capacity used when none is given.
+    static constexpr int DEFAULT_CAPACITY = 1 << 16;
+
+    /// The size of the writer's buffer in bytes.
+    static constexpr std::size_t BUFFER_BYTES = 1 << 20;
+
+    /// TelemetrySink Constructor creates a sink that is not yet open.
+    TelemetrySink();
+
+    /// TelemetrySink Destructor closes the sink.
+    ~TelemetrySink();
+
+    TelemetrySink(const TelemetrySink &) = delete;
+    TelemetrySink &operator=(const TelemetrySink &) = delete;
+
+    /// open creates (or truncates) the log file and starts the writer.
+    /// @param [in] path The log file.
+    /// @param [in] format The layout of the log.
+    /// @param [in] queueCapacity The most records queued at once; rounded
+    /// up to a power of two.
+    /// @return true if the sink is open.
+    bool open(const std::string &path, TelemetryFormat format,
+              int queueCapacity = DEFAULT_CAPACITY);
+
+    /// record queues a record without blocking.
+    /// @param [in] source The thread or shard making the record.
+    /// @param [in] round The round of the simulation.
+    /// @param [in] operation The measured operation.
+    /// @param [in] count The operation's result.
+    /// @param [in] latencyNanoseconds How long the operation took.
+    /// @return false if the record was dropped (queue full or sink closed).
+    bool record(std::uint32_t source, std::uint32_t round,
+                TelemetryOperation operation, std::int64_t count,
+                std::uint64_t latencyNanoseconds);
+
+    /// close writes every queued record, stops the writer and closes the
+    /// log file. Does nothing if the sink is not open.
+    /// @return false if any write to the log file failed.
+    bool close();
+
+    /// isOpen reports whether records are being accepted.
+    bool isOpen() const;
+
+    /// getDroppedCount returns the number of records dropped by a full queue.
+    std::uint64_t getDroppedCount() const;
+
+    /// getWrittenCount returns the number of records the writer has taken
+    /// off the queue for the file.
+    std::uint64_t getWrittenCount() const;
+
+};
+
+
+#endif //INC_5011_P4_TELEMETRYSINK_H
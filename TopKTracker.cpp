@@ -0,0 +1,266 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include "TopKTracker.h"
+
+
+namespace {
+
+/// mixValue spreads a value over the bits used to pick a table slot.
+std::uint64_t mixValue(std::uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+/// reportsBefore orders entries by larger count, then smaller value.
+bool reportsBefore(const TopKEntry &first, const TopKEntry &second) {
+    if (first.count != second.count) {
+        return first.count > second.count;
+    }
+    return first.value < second.value;
+}
+
+} // namespace
+
+
+int TopKTracker::findSlot(std::uint64_t value) const {
+    int slot = static_cast<int>(mixValue(value) & tableMask);
+
+    while ((valueTable[slot] >= 0) && (entries[valueTable[slot]].value != value)) {
+        slot = (slot + 1) & tableMask;
+    }
+
+    return slot;
+}
+
+void TopKTracker::removeValue(std::uint64_t value) {
+    int hole = findSlot(value);
+    int next = (hole + 1) & tableMask;
+
+    while (valueTable[next] >= 0) {
+        int home = static_cast<int>(
+                mixValue(entries[valueTable[next]].value) & tableMask);
+
+        // move the entry back unless its home lies between the hole and it
+        if (((next - home) & tableMask) >= ((next - hole) & tableMask)) {
+            valueTable[hole] = valueTable[next];
+            hole = next;
+        }
+        next = (next + 1) & tableMask;
+    }
+
+    valueTable[hole] = -1;
+}
+
+void TopKTracker::swapHeap(int first, int second) {
+    std::swap(heap[first], heap[second]);
+    heapPosition[heap[first]] = first;
+    heapPosition[heap[second]] = second;
+}
+
+void TopKTracker::siftUp(int position) {
+    while (position > 0) {
+        int parent = (position - 1) / 2;
+        if (entries[heap[parent]].count <= entries[heap[position]].count) {
+            return;
+        }
+        swapHeap(parent, position);
+        position = parent;
+    }
+}
+
+void TopKTracker::siftDown(int position) {
+    while (true) {
+        int smallest = position;
+        int left = 2 * position + 1;
+        int right = left + 1;
+
+        if ((left < usedCount) &&
+            (entries[heap[left]].count < entries[heap[smallest]].count)) {
+            smallest = left;
+        }
+        if ((right < usedCount) &&
+            (entries[heap[right]].count < entries[heap[smallest]].count)) {
+            smallest = right;
+        }
+        if (smallest == position) {
+            return;
+        }
+
+        swapHeap(position, smallest);
+        position = smallest;
+    }
+}
+
+
+TopKTracker::TopKTracker(int k, int counters) {
+    reportSize = std::max(k, 1);
+    counterCount = std::max(counters > 0 ? counters :
+                            DEFAULT_COUNTERS_PER_ENTRY * reportSize,
+                            reportSize);
+    usedCount = 0;
+    totalCount = 0;
+
+    int tableSize = 1;
+    while (tableSize < 2 * counterCount) {
+        tableSize *= 2;
+    }
+    tableMask = tableSize - 1;
+
+    entries = new TopKEntry[counterCount];
+    heap = new int[counterCount];
+    heapPosition = new int[counterCount];
+    valueTable = new int[tableSize];
+    std::fill(valueTable, valueTable + tableSize, -1);
+}
+
+TopKTracker::~TopKTracker() {
+    delete[] entries;
+    delete[] heap;
+    delete[] heapPosition;
+    delete[] valueTable;
+}
+
+TopKTracker::TopKTracker(const TopKTracker &sourceObject) {
+    reportSize = sourceObject.reportSize;
+    counterCount = sourceObject.counterCount;
+    usedCount = sourceObject.usedCount;
+    totalCount = sourceObject.totalCount;
+    tableMask = sourceObject.tableMask;
+
+    entries = nullptr;
+    heap = nullptr;
+    heapPosition = nullptr;
+    valueTable = nullptr;
+
+    if (sourceObject.entries != nullptr) {
+        entries = new TopKEntry[counterCount];
+        heap = new int[counterCount];
+        heapPosition = new int[counterCount];
+        valueTable = new int[tableMask + 1];
+
+        std::memcpy(entries, sourceObject.entries, counterCount * sizeof(TopKEntry));
+        std::memcpy(heap, sourceObject.heap, counterCount * sizeof(int));
+        std::memcpy(heapPosition, sourceObject.heapPosition, counterCount * sizeof(int));
+        std::memcpy(valueTable, sourceObject.valueTable, (tableMask + 1) * sizeof(int));
+    }
+}
+
+TopKTracker::TopKTracker(TopKTracker &&sourceObject) {
+    reportSize = sourceObject.reportSize;
+    counterCount = sourceObject.counterCount;
+    usedCount = sourceObject.usedCount;
+    totalCount = sourceObject.totalCount;
+    tableMask = sourceObject.tableMask;
+    entries = sourceObject.entries;
+    heap = sourceObject.heap;
+    heapPosition = sourceObject.heapPosition;
+    valueTable = sourceObject.valueTable;
+
+    // clear the source
+    sourceObject.counterCount = 0;
+    sourceObject.usedCount = 0;
+    sourceObject.totalCount = 0;
+    sourceObject.entries = nullptr;
+    sourceObject.heap = nullptr;
+    sourceObject.heapPosition = nullptr;
+    sourceObject.valueTable = nullptr;
+}
+
+TopKTracker &TopKTracker::operator=(const TopKTracker &sourceObject) {
+
+    // check to verify they're not the same object
+    if (this != &sourceObject) {
+        TopKTracker tempObject(sourceObject);
+        *this = std::move(tempObject);
+    }
+
+    return *this;
+}
+
+TopKTracker &TopKTracker::operator=(TopKTracker &&sourceObject) {
+
+    // swap contents
+    std::swap(reportSize, sourceObject.reportSize);
+    std::swap(counterCount, sourceObject.counterCount);
+    std::swap(usedCount, sourceObject.usedCount);
+    std::swap(totalCount, sourceObject.totalCount);
+    std::swap(tableMask, sourceObject.tableMask);
+    std::swap(entries, sourceObject.entries);
+    std::swap(heap, sourceObject.heap);
+    std::swap(heapPosition, sourceObject.heapPosition);
+    std::swap(valueTable, sourceObject.valueTable);
+
+    return *this;
+}
+
+void TopKTracker::add(std::uint64_t value, long long weight) {
+    if ((entries == nullptr) || (weight <= 0)) {
+        return;
+    }
+
+    totalCount += weight;
+    int slot = findSlot(value);
+
+    if (valueTable[slot] >= 0) {
+        // the value already has a counter
+        int counter = valueTable[slot];
+        entries[counter].count += weight;
+        siftDown(heapPosition[counter]);
+    } else if (usedCount < counterCount) {
+        // take a free counter
+        int counter = usedCount;
+        entries[counter] = TopKEntry{value, weight, 0};
+        valueTable[slot] = counter;
+        heap[usedCount] = counter;
+        heapPosition[counter] = usedCount;
+        usedCount++;
+        siftUp(heapPosition[counter]);
+    } else {
+        // replace the value with the smallest count, which bounds how often
+        // the new value may have been seen before
+        int counter = heap[0];
+        removeValue(entries[counter].value);
+        valueTable[findSlot(value)] = counter;
+
+        entries[counter].error = entries[counter].count;
+        entries[counter].value = value;
+        entries[counter].count += weight;
+        siftDown(0);
+    }
+}
+
+int TopKTracker::report(TopKEntry *topEntries) const {
+    int reported = std::min(reportSize, usedCount);
+
+    std::partial_sort_copy(entries, entries + usedCount,
+                           topEntries, topEntries + reported, reportsBefore);
+
+    return reported;
+}
+
+void TopKTracker::clear() {
+    usedCount = 0;
+    totalCount = 0;
+
+    if (valueTable != nullptr) {
+        std::fill(valueTable, valueTable + tableMask + 1, -1);
+    }
+}
+
+int TopKTracker::getK() const {
+    return reportSize;
+}
+
+int TopKTracker::getCounterCount() const {
+    return counterCount;
+}
+
+long long TopKTracker::getTotal() const {
+    return totalCount;
+}
@@ -0,0 +1,158 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_TOPKTRACKER_H
+#define INC_5011_P4_TOPKTRACKER_H
+
+#include <cstdint>
+
+
+/*
+ * TopKTracker reports the most frequent values of a stream in a single pass
+ * and bounded memory, using the Space-Saving algorithm (Metwally, Agrawal
+ * and El Abbadi, 2005). DuelingJP and CompressedDuelingJP feed it the
+ * outputs of a counting pass, so the primes that attract the most jumpers
+ * are known without a second traversal.
+ *
+ * The tracker keeps a fixed number of counters. A value that already has a
+ * counter increments it; a new value takes a free counter or, when none is
+ * free, replaces the value with the smallest count and inherits that count
+ * (recorded as the new counter's error).
+ *
+ * METHODS:
+ * 1. add() records one occurrence of a value (or several, with a weight).
+ * 2. report() writes the k values with the largest counts, largest first.
+ *
+ * ASSUMPTIONS:
+ * 1. A reported count never underestimates the true frequency and
+ * overestimates it by at most the entry's error. The error of any counter
+ * is at most total / counters, so with c counters every value occurring
+ * more than total / c times is tracked and a value whose count minus error
+ * exceeds the (k+1)th count is guaranteed to be in the true top k.
+ * 2. When every value fits in the counters (no counter was ever replaced),
+ * the counts are exact and every error is 0.
+ */
+
+/// TopKEntry is one reported value and its frequency.
+struct TopKEntry {
+    /// The tracked value.
+    std::uint64_t value;
+
+    /// The number of occurrences counted, an upper bound on the frequency.
+    long long count;
+
+    /// The most by which count may overestimate the frequency.
+    long long error;
+};
+
+/// TopKTracker finds the most frequent values of a stream.
+class TopKTracker {
+
+    /// The number of entries report() returns.
+    int reportSize;
+
+    /// The number of counters.
+    int counterCount;
+
+    /// The number of counters in use.
+    int usedCount;
+
+    /// The sum of every weight added.
+    long long totalCount;
+
+    /// The counters, in no particular order.
+    TopKEntry *entries;
+
+    /// Min-heap of counter numbers, ordered by count.
+    int *heap;
+
+    /// The position of each counter in heap.
+    int *heapPosition;
+
+    /// Open-addressed table of counter numbers by value (-1 marks an empty
+    /// slot); its size is a power of two at least twice counterCount.
+    int *valueTable;
+
+    /// The number of slots in valueTable, minus one.
+    int tableMask;
+
+    /// findSlot returns the slot of valueTable holding a value's counter,
+    /// or the empty slot where it would go.
+    int findSlot(std::uint64_t value) const;
+
+    /// removeValue removes a value's counter from valueTable, shifting
+    /// later entries of its probe run back so no tombstone is needed.
+    void removeValue(std::uint64_t value);
+
+    /// siftUp and siftDown restore the heap order after a count changes.
+    void siftUp(int position);
+    void siftDown(int position);
+
+    /// swapHeap exchanges two heap positions.
+    void swapHeap(int first, int second);
+
+public:
+
+    /// The number of counters kept per reported entry when none is given.
+    static constexpr int DEFAULT_COUNTERS_PER_ENTRY = 8;
+
+    /// TopKTracker Constructor creates an empty tracker.
+    /// @param [in] k The number of entries to report (at least 1).
+    /// @param [in] counters The number of counters to keep (at least k).
+    /// More counters make the counts more accurate. Defaults to
+    /// DEFAULT_COUNTERS_PER_ENTRY * k.
+    explicit TopKTracker(int k, int counters = 0);
+
+    /// TopKTracker Destructor releases the counters.
+    ~TopKTracker();
+
+    /// TopKTracker Copy Constructor copies a tracker.
+    /// @param [in] sourceObject The tracker to copy.
+    TopKTracker(const TopKTracker &sourceObject);
+
+    /// TopKTracker Move Constructor takes over a tracker.
+    /// @param [in] sourceObject The tracker to move; left with no counters.
+    TopKTracker(TopKTracker &&sourceObject);
+
+    /// TopKTracker assignment operator copies a tracker.
+    /// @param [in] sourceObject The tracker to copy.
+    /// @return A reference to this tracker.
+    TopKTracker &operator=(const TopKTracker &sourceObject);
+
+    /// TopKTracker move assignment operator swaps two trackers.
+    /// @param [in] sourceObject The tracker to move.
+    /// @return A reference to this tracker.
+    TopKTracker &operator=(TopKTracker &&sourceObject);
+
+    /// add records occurrences of a value.
+    /// @param [in] value The value seen.
+    /// @param [in] weight The number of occurrences (at least 1).
+    void add(std::uint64_t value, long long weight = 1);
+
+    /// report writes the most frequent values, largest count first (ties
+    /// by smaller value).
+    /// @param [out] topEntries Array of at least getK() entries.
+    /// @return The number of entries written: getK(), or fewer if fewer
+    /// distinct values were added.
+    int report(TopKEntry *topEntries) const;
+
+    /// clear forgets every value added.
+    void clear();
+
+    /// getK returns the number of entries report() returns.
+    /// @return k.
+    int getK() const;
+
+    /// getCounterCount returns the number of counters.
+    /// @return The number of counters.
+    int getCounterCount() const;
+
+    /// getTotal returns the sum of every weight added.
+    /// @return The number of occurrences recorded.
+    long long getTotal() const;
+
+};
+
+
+#endif //INC_5011_P4_TOPKTRACKER_H
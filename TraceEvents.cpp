@@ -0,0 +1,162 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <vector>
+#include "TraceEvents.h"
+
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/// traceEpoch is the time the trace clock started.
+Clock::time_point traceEpoch() {
+    static const Clock::time_point epoch = Clock::now();
+    return epoch;
+}
+
+/// writeMicroseconds writes a nanosecond time as fractional microseconds,
+/// the unit of trace-event timestamps.
+void writeMicroseconds(std::ostream &output, std::uint64_t nanoseconds) {
+    output << nanoseconds / 1000 << ".";
+    std::uint64_t fraction = nanoseconds % 1000;
+    if (fraction < 100) {
+        output << "0";
+    }
+    if (fraction < 10) {
+        output << "0";
+    }
+    output << fraction;
+}
+
+} // namespace
+
+
+namespace TraceEvents {
+
+PerThreadRegistry<TraceBlock> &registry() {
+    // never destroyed, so threads exiting during shutdown can still
+    // release their blocks
+    static PerThreadRegistry<TraceBlock> *traceRegistry =
+            new PerThreadRegistry<TraceBlock>;
+    return *traceRegistry;
+}
+
+std::uint32_t threadId() {
+    static std::atomic<std::uint32_t> nextThreadId{1};
+    thread_local std::uint32_t localThreadId =
+            nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return localThreadId;
+}
+
+std::uint64_t now() {
+    std::chrono::nanoseconds elapsed = Clock::now() - traceEpoch();
+    return static_cast<std::uint64_t>(elapsed.count());
+}
+
+const char *spanName(TraceSpan span) {
+    switch (span) {
+        case TraceSpan::Construct:
+            return "JumpPrime::construct";
+        case TraceSpan::Jump:
+            return "JumpPrime::jump";
+        case TraceSpan::Reset:
+            return "JumpPrime::reset";
+        case TraceSpan::CollisionPass:
+            return "DuelingJP::collisionPass";
+        case TraceSpan::InversionPass:
+            return "DuelingJP::inversionPass";
+        case TraceSpan::QueryPhase:
+            return "DuelingJP::queryPhase";
+        case TraceSpan::MatchPhase:
+            return "DuelingJP::matchPhase";
+        default:
+            return "unknown";
+    }
+}
+
+std::uint64_t droppedSpans() {
+    std::uint64_t dropped = 0;
+
+    if (enabled()) {
+        registry().forEach([&dropped](const TraceBlock &block) {
+            std::uint64_t written = block.written.load(std::memory_order_acquire);
+            if (written > static_cast<std::uint64_t>(TRACE_RING_CAPACITY)) {
+                dropped += written - TRACE_RING_CAPACITY;
+            }
+        });
+    }
+
+    return dropped;
+}
+
+void exportChromeTrace(std::ostream &output) {
+    std::vector<TraceRecord> spans;
+
+    if (enabled()) {
+        registry().forEach([&spans](const TraceBlock &block) {
+            std::uint64_t written = block.written.load(std::memory_order_acquire);
+            std::uint64_t kept = std::min<std::uint64_t>(written, TRACE_RING_CAPACITY);
+
+            for (std::uint64_t i = written - kept; i < written; i++) {
+                spans.push_back(block.records[i % TRACE_RING_CAPACITY]);
+            }
+        });
+    }
+
+    // viewers nest spans on a track by start time, outer span first
+    std::sort(spans.begin(), spans.end(),
+              [](const TraceRecord &a, const TraceRecord &b) {
+                  if (a.startNanoseconds != b.startNanoseconds) {
+                      return a.startNanoseconds < b.startNanoseconds;
+                  }
+                  return a.durationNanoseconds > b.durationNanoseconds;
+              });
+
+    std::set<std::uint32_t> threadIds;
+    for (const TraceRecord &span : spans) {
+        threadIds.insert(span.threadId);
+    }
+
+    output << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+
+    for (std::uint32_t id : threadIds) {
+        output << (first ? "\n" : ",\n")
+               << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << id
+               << ",\"args\":{\"name\":\"jumpprime-" << id << "\"}}";
+        first = false;
+    }
+
+    for (const TraceRecord &span : spans) {
+        output << (first ? "\n" : ",\n")
+               << "{\"name\":\"" << spanName(span.span)
+               << "\",\"cat\":\"jumpprime\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+               << span.threadId << ",\"ts\":";
+        writeMicroseconds(output, span.startNanoseconds);
+        output << ",\"dur\":";
+        writeMicroseconds(output, span.durationNanoseconds);
+        output << ",\"args\":{\"value\":" << span.value << "}}";
+        first = false;
+    }
+
+    output << "\n]}\n";
+}
+
+bool writeChromeTrace(const std::string &path) {
+    std::ofstream traceFile(path, std::ios::out | std::ios::trunc);
+    if (!traceFile) {
+        return false;
+    }
+
+    exportChromeTrace(traceFile);
+    traceFile.flush();
+
+    return static_cast<bool>(traceFile);
+}
+
+} // namespace TraceEvents
@@ -0,0 +1,192 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_TRACEEVENTS_H
+#define INC_5011_P4_TRACEEVENTS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include "PerThread.h"
+
+#if defined(JP_ENABLE_TRACING) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define JP_HAVE_USDT 1
+#endif
+#endif
+
+
+/*
+ * Trace events for JumpPrime and DuelingJP.
+ *
+ * When the library is built with JP_ENABLE_TRACING (the CMake option
+ * P4_ENABLE_TRACING), JumpPrime construction, jumps and resets and the
+ * DuelingJP counting passes (and their query and match phases) are
+ * recorded as timed spans. Each thread writes its spans into its own ring
+ * buffer; once full, the oldest spans of that thread are overwritten.
+ * writeChromeTrace() flushes every thread's spans to the Chrome
+ * trace-event JSON format, which chrome://tracing and Perfetto open
+ * directly, one track per thread.
+ *
+ * If <sys/sdt.h> is available the same sites are also Linux USDT probes
+ * (provider "jumpprime", probes "span_begin" with span and value, and
+ * "span_end" with span, value and duration in nanoseconds), which perf
+ * and bpftrace can attach to at no cost while unused.
+ *
+ * Without JP_ENABLE_TRACING the JP_TRACE_SCOPE macro expands to nothing
+ * and the export writes an empty trace.
+ *
+ * ASSUMPTIONS:
+ * 1. The export is taken while the traced threads are idle (for example
+ * after they are joined). Spans recorded during the export may be missing
+ * or, if a ring wraps meanwhile, torn.
+ */
+
+/// TraceSpan names the traced operations.
+enum class TraceSpan : std::uint32_t {
+    Construct,
+    Jump,
+    Reset,
+    CollisionPass,
+    InversionPass,
+    QueryPhase,
+    MatchPhase,
+    Count
+};
+
+/// The number of traced operations.
+const int TRACE_SPAN_COUNT = static_cast<int>(TraceSpan::Count);
+
+/// The number of spans each thread keeps before overwriting the oldest.
+const int TRACE_RING_CAPACITY = 1 << 14;
+
+/// TraceRecord is one completed span.
+struct TraceRecord {
+    std::uint64_t startNanoseconds;
+    std::uint64_t durationNanoseconds;
+    std::uint32_t value;
+    std::uint32_t threadId;
+    TraceSpan span;
+};
+
+/// TraceBlock is one thread's ring buffer of spans.
+struct alignas(64) TraceBlock {
+    TraceRecord records[TRACE_RING_CAPACITY];
+    std::atomic<std::uint64_t> written{0};
+    std::atomic<bool> inUse{false};
+    TraceBlock *next = nullptr;
+};
+
+namespace TraceEvents {
+
+/// registry returns the list of every thread's trace block.
+PerThreadRegistry<TraceBlock> &registry();
+
+/// localBlock returns the calling thread's trace block.
+inline TraceBlock *localBlock() {
+    thread_local ThreadBlockHandle<TraceBlock> handle(registry());
+    return handle.get();
+}
+
+/// threadId returns a small number identifying the calling thread in the
+/// trace, in the order threads first record a span.
+std::uint32_t threadId();
+
+/// now returns the time since the trace clock started.
+/// @return The time in nanoseconds.
+std::uint64_t now();
+
+/// record appends one completed span to the calling thread's ring.
+/// @param [in] span The traced operation.
+/// @param [in] value The operation's argument (a number or a size).
+/// @param [in] startNanoseconds When the span began.
+/// @param [in] durationNanoseconds How long the span took.
+inline void record(TraceSpan span, std::uint32_t value,
+                   std::uint64_t startNanoseconds,
+                   std::uint64_t durationNanoseconds) {
+    TraceBlock *block = localBlock();
+    std::uint64_t position = block->written.load(std::memory_order_relaxed);
+
+    TraceRecord &slot = block->records[position % TRACE_RING_CAPACITY];
+    slot.startNanoseconds = startNanoseconds;
+    slot.durationNanoseconds = durationNanoseconds;
+    slot.value = value;
+    slot.threadId = threadId();
+    slot.span = span;
+
+    block->written.store(position + 1, std::memory_order_release);
+}
+
+/// enabled reports whether the library was built with tracing.
+/// @return true if JP_ENABLE_TRACING was defined.
+constexpr bool enabled() {
+#ifdef JP_ENABLE_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// spanName returns a printable name for a span.
+/// @param [in] span The traced operation.
+/// @return The span's name.
+const char *spanName(TraceSpan span);
+
+/// droppedSpans returns the number of spans overwritten in full rings.
+/// @return The number of spans missing from the export.
+std::uint64_t droppedSpans();
+
+/// exportChromeTrace writes every recorded span as a Chrome trace-event
+/// JSON object.
+/// @param [in] output The stream to write to.
+void exportChromeTrace(std::ostream &output);
+
+/// writeChromeTrace writes the Chrome trace-event JSON to a file.
+/// @param [in] path The file to create or replace.
+/// @return true if the file was written.
+bool writeChromeTrace(const std::string &path);
+
+/// TraceScope records one span from its construction to its destruction.
+class TraceScope {
+    TraceSpan span;
+    std::uint32_t value;
+    std::uint64_t start;
+
+public:
+    TraceScope(TraceSpan tracedSpan, std::uint32_t spanValue)
+            : span(tracedSpan), value(spanValue), start(now()) {
+#ifdef JP_HAVE_USDT
+        DTRACE_PROBE2(jumpprime, span_begin,
+                      static_cast<std::uint32_t>(span), value);
+#endif
+    }
+
+    ~TraceScope() {
+        std::uint64_t duration = now() - start;
+#ifdef JP_HAVE_USDT
+        DTRACE_PROBE3(jumpprime, span_end,
+                      static_cast<std::uint32_t>(span), value, duration);
+#endif
+        record(span, value, start, duration);
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+};
+
+} // namespace TraceEvents
+
+#ifdef JP_ENABLE_TRACING
+#define JP_TRACE_SCOPE(span, value) \
+    TraceEvents::TraceScope jpTraceScope(TraceSpan::span, \
+                                         static_cast<std::uint32_t>(value))
+#else
+#define JP_TRACE_SCOPE(span, value) ((void) 0)
+#endif
+
+
+#endif //INC_5011_P4_TRACEEVENTS_H
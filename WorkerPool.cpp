@@ -0,0 +1,172 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <algorithm>
+#include <cstdlib>
+#include <pthread.h>
+#include <sched.h>
+#include "WorkerPool.h"
+
+
+namespace {
+
+/// pinCurrentThread pins the calling thread to one CPU.
+/// @return false if the CPU cannot be used by this process.
+bool pinCurrentThread(int cpu) {
+    if ((cpu < 0) || (cpu >= CPU_SETSIZE)) {
+        return false;
+    }
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+}
+
+} // namespace
+
+
+WorkerPool::WorkerPool(int workerCount, const std::vector<int> &cpus) {
+    currentJob = nullptr;
+    jobGeneration = 0;
+    unfinishedWorkers = 0;
+    pinnedWorkers = 0;
+    startedWorkers = 0;
+    stopping = false;
+
+    int count = std::max(1, workerCount);
+    for (int w = 0; w < count; w++) {
+        workerCpus.push_back(cpus.empty() ? -1 : cpus[w % cpus.size()]);
+    }
+
+    workers.reserve(count);
+    for (int w = 0; w < count; w++) {
+        workers.emplace_back(&WorkerPool::runWorker, this, w);
+    }
+
+    // every worker has pinned itself before the first job
+    std::unique_lock<std::mutex> lock(poolMutex);
+    jobDone.wait(lock, [this, count]() {
+        return startedWorkers == count;
+    });
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        stopping = true;
+    }
+    jobReady.notify_all();
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::run(const std::function<void(int)> &job) {
+    std::unique_lock<std::mutex> lock(poolMutex);
+    currentJob = &job;
+    unfinishedWorkers = static_cast<int>(workers.size());
+    jobGeneration++;
+    jobReady.notify_all();
+
+    jobDone.wait(lock, [this]() {
+        return unfinishedWorkers == 0;
+    });
+    currentJob = nullptr;
+}
+
+int WorkerPool::getWorkerCount() const {
+    return static_cast<int>(workers.size());
+}
+
+int WorkerPool::getPinnedCount() const {
+    // fixed once the constructor has returned
+    return pinnedWorkers;
+}
+
+int WorkerPool::getWorkerCpu(int workerNumber) const {
+    return workerCpus[workerNumber];
+}
+
+bool WorkerPool::parseCpuList(const char *listText, std::vector<int> &cpus) {
+    cpus.clear();
+    const char *position = listText;
+
+    while (true) {
+        char *end;
+        long first = std::strtol(position, &end, 10);
+        if ((end == position) || (first < 0)) {
+            return false;
+        }
+        long last = first;
+        position = end;
+
+        if (*position == '-') {
+            position++;
+            last = std::strtol(position, &end, 10);
+            if ((end == position) || (last < first)) {
+                return false;
+            }
+            position = end;
+        }
+        if (last >= CPU_SETSIZE) {
+            return false;
+        }
+        for (long cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+
+        if (*position == '\0') {
+            return true;
+        }
+        if (*position != ',') {
+            return false;
+        }
+        position++;
+    }
+}
+
+void WorkerPool::runWorker(int workerNumber) {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (workerCpus[workerNumber] >= 0) {
+            if (pinCurrentThread(workerCpus[workerNumber])) {
+                pinnedWorkers++;
+            } else {
+                workerCpus[workerNumber] = -1;
+            }
+        }
+        startedWorkers++;
+    }
+    jobDone.notify_all();
+
+    long long lastGeneration = 0;
+    while (true) {
+        const std::function<void(int)> *job;
+        {
+            std::unique_lock<std::mutex> lock(poolMutex);
+            jobReady.wait(lock, [this, lastGeneration]() {
+                return stopping || (jobGeneration != lastGeneration);
+            });
+            if (stopping) {
+                return;
+            }
+            lastGeneration = jobGeneration;
+            job = currentJob;
+        }
+
+        (*job)(workerNumber);
+
+        bool lastToFinish;
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            unfinishedWorkers--;
+            lastToFinish = (unfinishedWorkers == 0);
+        }
+        if (lastToFinish) {
+            jobDone.notify_all();
+        }
+    }
+}
@@ -0,0 +1,120 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#ifndef INC_5011_P4_WORKERPOOL_H
+#define INC_5011_P4_WORKERPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/*
+ * WorkerPool is a fixed set of worker threads that run the same job on
+ * every worker, for parallel DuelingJP work that repeats round after round.
+ *
+ * The workers live as long as the pool, so worker w is the same thread in
+ * every round. A caller that gives worker w the same share of the work
+ * each round (for example, one DuelingJP object per worker) keeps that
+ * share's data in the same core's caches from one round to the next. A
+ * share that worker w allocates and fills inside a job is also first
+ * touched by worker w, so on a machine with several memory nodes its pages
+ * are placed on the node of that worker's CPU rather than on the node of
+ * the thread that created the pool.
+ *
+ * Workers can be pinned to CPUs so that they do not migrate: given a CPU
+ * list, worker w is pinned to CPU cpus[w % cpus.size()]. Without a list the
+ * workers run wherever the operating system schedules them.
+ *
+ * METHODS:
+ * 1. run calls job(w) on every worker w and returns when all have
+ * finished.
+ * 2. parseCpuList reads CPU lists such as "0-3,8,10-11".
+ *
+ * ASSUMPTIONS:
+ * 1. run is called from one thread at a time, never from a worker.
+ * 2. A CPU that does not exist or is not allowed for this process cannot
+ * be pinned to; that worker runs unpinned, and getPinnedCount reports
+ * how many workers were pinned.
+ */
+
+/// WorkerPool runs jobs on a fixed set of (optionally pinned) threads.
+class WorkerPool {
+
+    std::vector<std::thread> workers;
+
+    /// The CPU each worker is pinned to, or -1 if it is not pinned.
+    std::vector<int> workerCpus;
+
+    /// Guards everything below.
+    std::mutex poolMutex;
+    std::condition_variable jobReady;
+    std::condition_variable jobDone;
+
+    /// The job of the current round.
+    const std::function<void(int)> *currentJob;
+
+    /// Incremented for every job, so workers can tell a new job from the
+    /// one they last ran.
+    long long jobGeneration;
+
+    /// The workers still running the current job.
+    int unfinishedWorkers;
+
+    /// The workers that pinned themselves successfully.
+    int pinnedWorkers;
+
+    /// The workers that have started (and tried to pin themselves).
+    int startedWorkers;
+
+    bool stopping;
+
+    /// runWorker pins the worker and runs each job until the pool stops.
+    /// @param [in] workerNumber The worker.
+    void runWorker(int workerNumber);
+
+public:
+
+    /// WorkerPool Constructor starts the workers and waits until each
+    /// has pinned itself.
+    /// @param [in] workerCount The number of workers (at least 1).
+    /// @param [in] cpus The CPUs to pin the workers to, reused in order if
+    /// there are more workers than CPUs; empty to leave them unpinned.
+    explicit WorkerPool(int workerCount, const std::vector<int> &cpus = std::vector<int>());
+
+    /// WorkerPool Destructor stops the workers.
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /// run calls job(workerNumber) on every worker and waits for all of
+    /// them to finish.
+    /// @param [in] job The job to run.
+    void run(const std::function<void(int)> &job);
+
+    /// getWorkerCount returns the number of workers.
+    int getWorkerCount() const;
+
+    /// getPinnedCount returns the number of workers pinned to a CPU.
+    int getPinnedCount() const;
+
+    /// getWorkerCpu returns the CPU a worker is pinned to.
+    /// @param [in] workerNumber The worker.
+    /// @return The CPU, or -1 if the worker is not pinned.
+    int getWorkerCpu(int workerNumber) const;
+
+    /// parseCpuList reads comma-separated CPU numbers and first-last
+    /// ranges (last included), e.g. "0-3,8".
+    /// @param [in] listText The list.
+    /// @param [out] cpus The CPUs, in the order listed.
+    /// @return false if the list is malformed.
+    static bool parseCpuList(const char *listText, std::vector<int> &cpus);
+
+};
+
+
+#endif //INC_5011_P4_WORKERPOOL_H
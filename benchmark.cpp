@@ -0,0 +1,529 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sched.h>
+#include "JumpPrime.h"
+#include "DuelingJP.h"
+#include "PopulationJoin.h"
+#include "WorkerPool.h"
+
+/*
+ * Microbenchmark suite for the JumpPrime prime search and the DuelingJP
+ * counting passes.
+ *
+ * Every case is run a number of untimed warm-up iterations, then timed for
+ * a number of repetitions (stopping early once the time budget of the case
+ * is used up, after at least one repetition). The results are printed as a
+ * table and written as JSON so runs from different builds can be compared.
+ *
+ * CASES:
+ * 1. isPrime/<seed>: isPrime on 64 consecutive integers starting at seed.
+ * 2. findPrime/<seed>: the next and the previous prime from seed.
+ * 3. setPrimeLimits/<seed>: both prime limits of a JumpPrime at seed.
+ * 4. countCollisions/<population>: one up() collision pass over a DuelingJP.
+ * 5. countInversions/<population>: one inversion pass over a DuelingJP.
+ * 6. isPrime64/<seed>, findPrime64/<seed>, setPrimeLimits64/<seed>: cases
+ * 1-3 for the 64-bit configuration (JumpPrime64). Its seeds range over
+ * 10^3 .. 10^18; up to 4*10^9 they overlap the 32-bit cases for a direct
+ * comparison.
+ * Seeds range over 10^3 .. 4*10^9 and populations over 10 .. 10^6. The
+ * DuelingJP populations use seeds drawn uniformly from [1000, 10000) with a
+ * fixed random seed, so the prime searches stay cheap and the counting
+ * itself dominates.
+ *
+ * USAGE:
+ *   5011_p4_bench [--json <path>] [--warmup <n>] [--reps <n>]
+ *                 [--budget <seconds>] [--max-seed <n>]
+ *                 [--max-wide-seed <n>] [--max-population <n>]
+ *                 [--filter <text>] [--quick]
+ * --max-wide-seed limits the 64-bit cases. --quick limits the run to seeds
+ * up to 10^6 (10^12 for the 64-bit cases) and populations up to 10^4.
+ * The full grid takes a long time: the prime search is trial division and
+ * the counting passes are quadratic in the population.
+ */
+
+
+/// JumpPrimeBenchmark exposes the private JumpPrime prime search to the
+/// benchmark cases.
+class JumpPrimeBenchmark {
+public:
+    static bool isPrime(JumpPrime &testJP, unsigned int testNumber) {
+        return testJP.isPrime(testNumber);
+    }
+
+    static unsigned int findPrime(JumpPrime &testJP, unsigned int startValue,
+                                  bool findNext) {
+        return testJP.findPrime(startValue, findNext);
+    }
+
+    static void setPrimeLimits(JumpPrime &testJP) {
+        testJP.setPrimeLimits();
+    }
+
+    static bool isPrime64(unsigned long long testNumber) {
+        return JumpPrime64::isPrime(testNumber);
+    }
+
+    static void setPrimeLimits(JumpPrime64 &testJP) {
+        testJP.setPrimeLimits();
+    }
+
+    /// findPrimeWith runs the prime search of another configuration.
+    template <class Traits>
+    static typename BasicJumpPrime<Traits>::Value
+    findPrimeWith(typename BasicJumpPrime<Traits>::Value startValue,
+                  bool findNext) {
+        return BasicJumpPrime<Traits>::findPrime(startValue, findNext);
+    }
+};
+
+
+namespace {
+
+/// BenchOptions holds the command line settings.
+struct BenchOptions {
+    int warmup = 1;
+    int repetitions = 5;
+    double budgetSeconds = 30.0;
+    unsigned long long maxSeed = 4000000000ull;
+    unsigned long long maxWideSeed = 1000000000000000000ull;
+    long long maxPopulation = 1000000;
+    std::string filter;
+    std::string jsonPath = "bench_output.json";
+};
+
+/// BenchResult holds the timing of one benchmark case.
+struct BenchResult {
+    std::string name;
+    std::string parameterName;
+    long long parameterValue;
+    long long itemsPerRepetition;
+    int warmup;
+    int repetitions;
+    double minNs;
+    double medianNs;
+    double meanNs;
+    double maxNs;
+};
+
+/// Results are folded in here so the optimizer cannot drop the work.
+volatile unsigned long long benchSink = 0;
+
+const unsigned long long SEED_MAGNITUDES[] = {
+        1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+        100000000ull, 1000000000ull, 4000000000ull};
+
+const unsigned long long WIDE_SEED_MAGNITUDES[] = {
+        1000ull, 1000000ull, 1000000000ull, 4000000000ull,
+        1000000000000ull, 1000000000000000ull, 1000000000000000000ull};
+
+const long long POPULATIONS[] = {10, 100, 1000, 10000, 100000, 1000000};
+
+const unsigned int PRIME_BATCH = 64;
+
+/// runCase times body() (which does itemsPerRepetition items of work).
+template <class Body>
+BenchResult runCase(const std::string &name, const char *parameterName,
+                    long long parameterValue, long long itemsPerRepetition,
+                    const BenchOptions &options, Body body) {
+    typedef std::chrono::steady_clock Clock;
+
+    for (int i = 0; i < options.warmup; i++) {
+        benchSink = benchSink + body();
+    }
+
+    std::vector<double> samples;
+    double elapsedSeconds = 0.0;
+    while ((static_cast<int>(samples.size()) < options.repetitions) &&
+           (samples.empty() || (elapsedSeconds < options.budgetSeconds))) {
+        Clock::time_point start = Clock::now();
+        benchSink = benchSink + body();
+        std::chrono::duration<double, std::nano> sample = Clock::now() - start;
+
+        samples.push_back(sample.count());
+        elapsedSeconds += sample.count() * 1e-9;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    double total = 0.0;
+    for (double sample : samples) {
+        total += sample;
+    }
+
+    BenchResult result;
+    result.name = name;
+    result.parameterName = parameterName;
+    result.parameterValue = parameterValue;
+    result.itemsPerRepetition = itemsPerRepetition;
+    result.warmup = options.warmup;
+    result.repetitions = static_cast<int>(samples.size());
+    result.minNs = samples.front();
+    result.medianNs = samples[samples.size() / 2];
+    result.meanNs = total / static_cast<double>(samples.size());
+    result.maxNs = samples.back();
+
+    return result;
+}
+
+bool isSelected(const std::string &name, const BenchOptions &options) {
+    return options.filter.empty() ||
+           (name.find(options.filter) != std::string::npos);
+}
+
+void printResult(const BenchResult &result) {
+    std::cout << result.name
+              << "  reps=" << result.repetitions
+              << "  median=" << result.medianNs << " ns"
+              << "  min=" << result.minNs << " ns"
+              << "  per item=" << result.medianNs /
+                                  static_cast<double>(result.itemsPerRepetition)
+              << " ns\n";
+}
+
+void runPrimeCases(const BenchOptions &options,
+                   std::vector<BenchResult> &results) {
+    for (unsigned long long magnitude : SEED_MAGNITUDES) {
+        if (magnitude > options.maxSeed) {
+            continue;
+        }
+        unsigned int seed = static_cast<unsigned int>(magnitude);
+        long long parameter = static_cast<long long>(magnitude);
+        JumpPrime testJP(seed);
+
+        std::string name = "isPrime/" + std::to_string(magnitude);
+        if (isSelected(name, options)) {
+            results.push_back(runCase(name, "seed", parameter, PRIME_BATCH,
+                                      options, [&]() {
+                unsigned long long primes = 0;
+                for (unsigned int i = 0; i < PRIME_BATCH; i++) {
+                    primes += JumpPrimeBenchmark::isPrime(testJP, seed + i);
+                }
+                return primes;
+            }));
+            printResult(results.back());
+        }
+
+        name = "findPrime/" + std::to_string(magnitude);
+        if (isSelected(name, options)) {
+            results.push_back(runCase(name, "seed", parameter, 2, options, [&]() {
+                return static_cast<unsigned long long>(
+                        JumpPrimeBenchmark::findPrime(testJP, seed, true)) +
+                       JumpPrimeBenchmark::findPrime(testJP, seed, false);
+            }));
+            printResult(results.back());
+        }
+
+        name = "findPrime/millerRabin/" + std::to_string(magnitude);
+        if (isSelected(name, options)) {
+            results.push_back(runCase(name, "seed", parameter, 2, options, [&]() {
+                return static_cast<unsigned long long>(
+                        JumpPrimeBenchmark::findPrimeWith<MillerRabinJumpTraits>(
+                                seed, true)) +
+                       JumpPrimeBenchmark::findPrimeWith<MillerRabinJumpTraits>(
+                               seed, false);
+            }));
+            printResult(results.back());
+        }
+
+        name = "setPrimeLimits/" + std::to_string(magnitude);
+        if (isSelected(name, options)) {
+            results.push_back(runCase(name, "seed", parameter, 1, options, [&]() {
+                JumpPrimeBenchmark::setPrimeLimits(testJP);
+                return static_cast<unsigned long long>(testJP.getCurrentValue());
+            }));
+            printResult(results.back());
+        }
+    }
+}
+
+void runWidePrimeCases(const BenchOptions &options,
+                       std::vector<BenchResult> &results) {
+    for (unsigned long long magnitude : WIDE_SEED_MAGNITUDES) {
+        if (magnitude > options.maxWideSeed) {
+            continue;
+        }
+        JumpPrime64::Value seed = magnitude;
+        long long parameter = static_cast<long long>(magnitude);
+        JumpPrime64 testJP(seed);
+
+        std::string name = "isPrime64/" + std::to_string(magnitude);
+        if (isSelected(name, options)) {
+            results.push_back(runCase(name, "seed", parameter, PRIME_BATCH,
+                                      options, [&]() {
+                unsigned long long primes = 0;
+                for (unsigned int i = 0; i < PRIME_BATCH; i++) {
+                    primes += JumpPrimeBenchmark::isPrime64(seed + i);
+                }
+                return primes;
+            }));
+            printResult(results.back());
+        }
+
+        name = "findPrime64/" + std::to_string(magnitude);
+        if (isSelected(name, options)) {
+            results.push_back(runCase(name, "seed", parameter, 2, options, [&]() {
+                return static_cast<unsigned long long>(
+                        JumpPrimeBenchmark::findPrimeWith<JumpTraits64>(seed, true)) +
+                       JumpPrimeBenchmark::findPrimeWith<JumpTraits64>(seed, false);
+            }));
+            printResult(results.back());
+        }
+
+        name = "setPrimeLimits64/" + std::to_string(magnitude);
+        if (isSelected(name, options)) {
+            results.push_back(runCase(name, "seed", parameter, 1, options, [&]() {
+                JumpPrimeBenchmark::setPrimeLimits(testJP);
+                return static_cast<unsigned long long>(testJP.getCurrentValue());
+            }));
+            printResult(results.back());
+        }
+    }
+}
+
+void runCountingCases(const BenchOptions &options,
+                      std::vector<BenchResult> &results) {
+    for (long long population : POPULATIONS) {
+        if (population > options.maxPopulation) {
+            continue;
+        }
+
+        std::string collisionName = "countCollisions/" + std::to_string(population);
+        std::string inversionName = "countInversions/" + std::to_string(population);
+        std::string joinName = "joinInversions/" + std::to_string(population);
+        if (!isSelected(collisionName, options) &&
+            !isSelected(inversionName, options) &&
+            !isSelected(joinName, options)) {
+            continue;
+        }
+
+        // the same seeds for every build, so results are comparable
+        std::mt19937 generator(5011);
+        std::uniform_int_distribution<int> seedDistribution(1000, 9999);
+        int *seeds = new int[population];
+        for (long long i = 0; i < population; i++) {
+            seeds[i] = seedDistribution(generator);
+        }
+        DuelingJP testDJP(seeds, static_cast<int>(population));
+        delete[] seeds;
+
+        if (isSelected(collisionName, options)) {
+            results.push_back(runCase(collisionName, "population", population,
+                                      population, options, [&]() {
+                return static_cast<unsigned long long>(testDJP.countCollisions());
+            }));
+            printResult(results.back());
+        }
+
+        if (isSelected(inversionName, options)) {
+            results.push_back(runCase(inversionName, "population", population,
+                                      population, options, [&]() {
+                return static_cast<unsigned long long>(testDJP.countInversions());
+            }));
+            printResult(results.back());
+        }
+
+        if (isSelected(joinName, options)) {
+            // a second population of the same size, joined against the first
+            int *otherSeeds = new int[population];
+            for (long long i = 0; i < population; i++) {
+                otherSeeds[i] = seedDistribution(generator);
+            }
+            DuelingJP otherDJP(otherSeeds, static_cast<int>(population));
+            delete[] otherSeeds;
+
+            results.push_back(runCase(joinName, "population", population,
+                                      2 * population, options, [&]() {
+                CrossInversions inversions = joinInversions(testDJP, otherDJP);
+                return static_cast<unsigned long long>(inversions.leftUpRightDown +
+                                                       inversions.rightUpLeftDown);
+            }));
+            printResult(results.back());
+        }
+    }
+}
+
+void runPoolCases(const BenchOptions &options,
+                  std::vector<BenchResult> &results) {
+    // one worker per CPU this process may use, pinned or not
+    std::vector<int> allowedCpus;
+    cpu_set_t allowedSet;
+    if (sched_getaffinity(0, sizeof(allowedSet), &allowedSet) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &allowedSet)) {
+                allowedCpus.push_back(cpu);
+            }
+        }
+    }
+    int workerCount = allowedCpus.empty() ?
+                      std::max(1, static_cast<int>(std::thread::hardware_concurrency())) :
+                      static_cast<int>(allowedCpus.size());
+
+    for (long long population : POPULATIONS) {
+        if ((population > options.maxPopulation) || (population < workerCount)) {
+            continue;
+        }
+
+        for (bool pinned : {false, true}) {
+            std::string name = std::string("poolCollisions/") +
+                               (pinned ? "pinned/" : "unpinned/") +
+                               std::to_string(population);
+            if (!isSelected(name, options)) {
+                continue;
+            }
+
+            // the same seeds as the counting cases
+            std::mt19937 generator(5011);
+            std::uniform_int_distribution<int> seedDistribution(1000, 9999);
+            int *seeds = new int[population];
+            for (long long i = 0; i < population; i++) {
+                seeds[i] = seedDistribution(generator);
+            }
+
+            // each worker builds and then counts its own share
+            WorkerPool pool(workerCount, pinned ? allowedCpus : std::vector<int>());
+            std::vector<DuelingJP *> shares(workerCount, nullptr);
+            pool.run([&](int w) {
+                long long first = population * w / workerCount;
+                long long last = population * (w + 1) / workerCount;
+                shares[w] = new DuelingJP(seeds + first, static_cast<int>(last - first));
+            });
+            delete[] seeds;
+
+            std::vector<long long> collisions(workerCount, 0);
+            results.push_back(runCase(name, "population", population,
+                                      population, options, [&]() {
+                pool.run([&](int w) {
+                    collisions[w] = shares[w]->countCollisions();
+                });
+                unsigned long long total = 0;
+                for (long long count : collisions) {
+                    total += static_cast<unsigned long long>(count);
+                }
+                return total;
+            }));
+            printResult(results.back());
+
+            pool.run([&](int w) {
+                delete shares[w];
+            });
+        }
+    }
+}
+
+bool writeJson(const std::vector<BenchResult> &results,
+               const BenchOptions &options) {
+    std::ofstream jsonFile(options.jsonPath);
+    if (!jsonFile) {
+        return false;
+    }
+
+#ifndef P4_BUILD_TYPE
+#define P4_BUILD_TYPE "unknown"
+#endif
+#ifndef P4_COMPILER
+#define P4_COMPILER "unknown"
+#endif
+
+    jsonFile << "{\n";
+    jsonFile << "  \"context\": {\n";
+    jsonFile << "    \"build_type\": \"" << P4_BUILD_TYPE << "\",\n";
+    jsonFile << "    \"compiler\": \"" << P4_COMPILER << "\",\n";
+    jsonFile << "    \"warmup\": " << options.warmup << ",\n";
+    jsonFile << "    \"repetitions\": " << options.repetitions << ",\n";
+    jsonFile << "    \"budget_seconds\": " << options.budgetSeconds << "\n";
+    jsonFile << "  },\n";
+    jsonFile << "  \"benchmarks\": [\n";
+
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const BenchResult &result = results[i];
+        jsonFile << "    {\"name\": \"" << result.name << "\", "
+                 << "\"" << result.parameterName << "\": "
+                 << result.parameterValue << ", "
+                 << "\"items_per_repetition\": " << result.itemsPerRepetition << ", "
+                 << "\"warmup\": " << result.warmup << ", "
+                 << "\"repetitions\": " << result.repetitions << ", "
+                 << "\"min_ns\": " << result.minNs << ", "
+                 << "\"median_ns\": " << result.medianNs << ", "
+                 << "\"mean_ns\": " << result.meanNs << ", "
+                 << "\"max_ns\": " << result.maxNs << "}"
+                 << ((i + 1 < results.size()) ? ",\n" : "\n");
+    }
+
+    jsonFile << "  ]\n";
+    jsonFile << "}\n";
+
+    return static_cast<bool>(jsonFile);
+}
+
+bool parseOptions(int argc, char *argv[], BenchOptions &options) {
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (option == "--quick") {
+            options.maxSeed = 1000000ull;
+            options.maxWideSeed = 1000000000000ull;
+            options.maxPopulation = 10000;
+        } else if ((option == "--json") && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if ((option == "--warmup") && hasValue) {
+            options.warmup = std::atoi(argv[++i]);
+        } else if ((option == "--reps") && hasValue) {
+            options.repetitions = std::max(1, std::atoi(argv[++i]));
+        } else if ((option == "--budget") && hasValue) {
+            options.budgetSeconds = std::atof(argv[++i]);
+        } else if ((option == "--max-seed") && hasValue) {
+            options.maxSeed = std::strtoull(argv[++i], nullptr, 10);
+        } else if ((option == "--max-wide-seed") && hasValue) {
+            options.maxWideSeed = std::strtoull(argv[++i], nullptr, 10);
+        } else if ((option == "--max-population") && hasValue) {
+            options.maxPopulation = std::atoll(argv[++i]);
+        } else if ((option == "--filter") && hasValue) {
+            options.filter = argv[++i];
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+
+int main(int argc, char *argv[]) {
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--json <path>] [--warmup <n>] [--reps <n>]"
+                     " [--budget <seconds>] [--max-seed <n>]"
+                     " [--max-wide-seed <n>] [--max-population <n>] [--filter <text>] [--quick]\n";
+        return 2;
+    }
+
+    std::vector<BenchResult> results;
+    runPrimeCases(options, results);
+    runWidePrimeCases(options, results);
+    runCountingCases(options, results);
+    runPoolCases(options, results);
+
+    if (!writeJson(results, options)) {
+        std::cerr << "could not write " << options.jsonPath << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << results.size() << " results to "
+              << options.jsonPath << "\n";
+
+    return 0;
+}
@@ -1,6 +1,12 @@
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include "JumpPrime.h"
 #include "DuelingJP.h"
+#include "StreamingDuelingJP.h"
+#include "LoadGenerator.h"
+#include "ParameterSweep.h"
+#include "ExperimentBatch.h"
 
 using std::cout;
 using std::endl;
@@ -185,7 +191,90 @@ void duelingTest() {
 
 }
 
-int main() {
+// evaluates a binary file of 32-bit seeds that may not fit in memory
+int streamTest(const char *seedPath, const char *capMegabytes) {
+    StreamConfig config;
+    if (capMegabytes != nullptr) {
+        // strtoul would silently wrap a negative cap
+        char *end;
+        unsigned long megabytes = std::strtoul(capMegabytes, &end, 10);
+        if ((*capMegabytes < '0') || (*capMegabytes > '9') || (*end != '\0') ||
+            (megabytes == 0) || (megabytes > (static_cast<std::size_t>(-1) >> 20))) {
+            std::cerr << "Invalid memory cap: " << capMegabytes << endl;
+            return 2;
+        }
+        config.memoryCapBytes = static_cast<std::size_t>(megabytes) << 20;
+    }
+
+    cout << "Streaming seeds from " << seedPath << endl;
+    StreamingDuelingJP streamer(config);
+    StreamReport report;
+    bool streamOk = streamer.evaluate(seedPath, report);
+    printStreamReport(report, cout);
+
+    if (!streamOk) {
+        if (report.trailingBytes != 0) {
+            cout << seedPath << " ends with a partial seed" << endl;
+        }
+        cout << "Error reading " << seedPath << endl;
+        return 1;
+    }
+    return 0;
+}
+
+// runs production-shaped load with the given load generator options
+int loadTest(int argc, char *argv[]) {
+    LoadConfig config;
+    if (!parseLoadConfig(argc, argv, config)) {
+        printLoadUsage(std::cerr);
+        return 2;
+    }
+
+    runLoadGenerator(config, cout);
+    return 0;
+}
+
+// sweeps jump values, jump bounds and populations (see ParameterSweep.h)
+int sweepTest(int argc, char *argv[]) {
+    SweepConfig config;
+    if (!parseSweepConfig(argc, argv, config)) {
+        printSweepUsage(std::cerr);
+        return 2;
+    }
+
+    return runParameterSweep(config, cout) ? 0 : 1;
+}
+
+// runs a batch of scheduled experiments (see ExperimentBatch.h)
+int experimentTest(int argc, char *argv[]) {
+    ExperimentBatchConfig config;
+    if (!parseExperimentBatchConfig(argc, argv, config)) {
+        printExperimentBatchUsage(std::cerr);
+        return 2;
+    }
+
+    return runExperimentBatch(config, cout) ? 0 : 1;
+}
+
+// with no arguments, runs the scripted demonstration
+// --stream <seed file> [memory cap in MB] evaluates a seed file
+// --load [options] runs the load generator (see LoadGenerator.h)
+// --sweep [options] runs a parameter sweep (see ParameterSweep.h)
+// --experiments [options] runs scheduled experiments (see ExperimentBatch.h)
+int main(int argc, char *argv[]) {
+    if ((argc >= 3) && (std::strcmp(argv[1], "--stream") == 0)) {
+        return streamTest(argv[2], (argc >= 4) ? argv[3] : nullptr);
+    }
+    if ((argc >= 2) && (std::strcmp(argv[1], "--load") == 0)) {
+        return loadTest(argc - 2, argv + 2);
+    }
+    if ((argc >= 2) && (std::strcmp(argv[1], "--sweep") == 0)) {
+        return sweepTest(argc - 2, argv + 2);
+    }
+    if ((argc >= 2) && (std::strcmp(argv[1], "--experiments") == 0)) {
+        return experimentTest(argc - 2, argv + 2);
+    }
+
     jumpPrimeTest();
 
     duelingTest();
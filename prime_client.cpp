@@ -0,0 +1,227 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "JumpPrime.h"
+#include "PrimeClient.h"
+
+/*
+ * Command line client of the nearest-prime daemon (5011_p4_primed).
+ *
+ * Given values, it prints the primes around each one. With --bench it
+ * instead runs a load test: each client thread opens its own connection
+ * and repeatedly looks up a batch of random values (the pipeline depth),
+ * then the throughput and the round-trip latency percentiles are printed.
+ * The answers of every thread's first batch are checked against the
+ * JumpPrime64 prime search in the client.
+ *
+ * USAGE:
+ *   5011_p4_prime_client [--socket <path>] <value>...
+ *   5011_p4_prime_client [--socket <path>] --bench [--clients <n>]
+ *                        [--requests <n>] [--depth <n>] [--max-value <n>]
+ *                        [--seed <n>]
+ * --requests is per client (default 100000), --depth is the number of
+ * requests per round trip (default 64) and values are drawn uniformly from
+ * [0, max-value] (default 10^12).
+ */
+
+namespace {
+
+/// ClientOptions holds the command line settings.
+struct ClientOptions {
+    std::string socketPath = PRIME_DEFAULT_SOCKET_PATH;
+    bool bench = false;
+    int clients = 4;
+    long long requests = 100000;
+    int depth = 64;
+    unsigned long long maxValue = 1000000000000ull;
+    unsigned int seed = 5011;
+    std::vector<std::uint64_t> values;
+};
+
+bool parseOptions(int argc, char *argv[], ClientOptions &options) {
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if ((option == "--socket") && hasValue) {
+            options.socketPath = argv[++i];
+        } else if (option == "--bench") {
+            options.bench = true;
+        } else if ((option == "--clients") && hasValue) {
+            options.clients = std::max(1, std::atoi(argv[++i]));
+        } else if ((option == "--requests") && hasValue) {
+            options.requests = std::max(1LL, std::atoll(argv[++i]));
+        } else if ((option == "--depth") && hasValue) {
+            options.depth = std::max(1, std::atoi(argv[++i]));
+        } else if ((option == "--max-value") && hasValue) {
+            options.maxValue = std::strtoull(argv[++i], nullptr, 10);
+        } else if ((option == "--seed") && hasValue) {
+            options.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (!option.empty() && (option[0] != '-')) {
+            options.values.push_back(std::strtoull(option.c_str(), nullptr, 10));
+        } else {
+            return false;
+        }
+    }
+
+    return options.bench || !options.values.empty();
+}
+
+/// matchesLocalSearch checks a response against the client's own search.
+bool matchesLocalSearch(std::uint64_t value, const PrimeResponse &response) {
+    std::uint64_t lowerPrime = (value <= 2) ? 0 : JumpPrime64::previousPrime(value);
+    std::uint64_t upperPrime = (value < 2) ? 2 : JumpPrime64::nextPrime(value);
+    bool hasUpper = (response.status & PrimeNoUpper) == 0;
+
+    return (response.lowerPrime == lowerPrime) &&
+           (!hasUpper || (response.upperPrime == upperPrime));
+}
+
+/// ClientResult is what one bench thread measured.
+struct ClientResult {
+    long long answered = 0;
+    long long mismatches = 0;
+    bool failed = false;
+    std::vector<double> latencies;
+};
+
+void runClient(const ClientOptions &options, int clientNumber,
+               ClientResult &result) {
+    PrimeClient client;
+    if (!client.connectTo(options.socketPath)) {
+        result.failed = true;
+        return;
+    }
+
+    std::mt19937_64 generator(options.seed + clientNumber);
+    std::uniform_int_distribution<std::uint64_t> valueDistribution(0, options.maxValue);
+    std::vector<std::uint64_t> values(options.depth);
+    std::vector<PrimeResponse> responses(options.depth);
+
+    for (long long sent = 0; sent < options.requests; sent += options.depth) {
+        int batch = static_cast<int>(std::min<long long>(options.depth,
+                                                         options.requests - sent));
+        for (int i = 0; i < batch; i++) {
+            values[i] = valueDistribution(generator);
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (!client.lookup(values.data(), batch, responses.data())) {
+            result.failed = true;
+            return;
+        }
+        std::chrono::duration<double, std::micro> elapsed =
+                std::chrono::steady_clock::now() - start;
+        result.latencies.push_back(elapsed.count());
+        result.answered += batch;
+
+        if (sent == 0) {
+            for (int i = 0; i < batch; i++) {
+                result.mismatches += matchesLocalSearch(values[i], responses[i]) ? 0 : 1;
+            }
+        }
+    }
+}
+
+double percentile(const std::vector<double> &sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    std::size_t index = static_cast<std::size_t>(fraction * (sorted.size() - 1));
+    return sorted[index];
+}
+
+int runBench(const ClientOptions &options) {
+    std::vector<ClientResult> results(options.clients);
+    std::vector<std::thread> threads;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.clients; i++) {
+        threads.emplace_back(runClient, std::cref(options), i, std::ref(results[i]));
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    long long answered = 0;
+    long long mismatches = 0;
+    bool failed = false;
+    std::vector<double> latencies;
+    for (const ClientResult &result : results) {
+        answered += result.answered;
+        mismatches += result.mismatches;
+        failed = failed || result.failed;
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << "Prime client: clients=" << options.clients
+              << "  depth=" << options.depth
+              << "  requests=" << answered
+              << "  requests/s=" << answered / elapsed.count()
+              << "  round trip p50=" << percentile(latencies, 0.50) << "us"
+              << "  p99=" << percentile(latencies, 0.99) << "us"
+              << "  max=" << (latencies.empty() ? 0.0 : latencies.back()) << "us"
+              << "  mismatches=" << mismatches << "\n";
+
+    if (failed) {
+        std::cerr << "could not reach the server at " << options.socketPath << "\n";
+    }
+
+    return (failed || (mismatches != 0)) ? 1 : 0;
+}
+
+} // namespace
+
+
+int main(int argc, char *argv[]) {
+    ClientOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0] << " [--socket <path>] <value>...\n"
+                  << "       " << argv[0] << " [--socket <path>] --bench"
+                     " [--clients <n>] [--requests <n>] [--depth <n>]"
+                     " [--max-value <n>] [--seed <n>]\n";
+        return 2;
+    }
+
+    if (options.bench) {
+        return runBench(options);
+    }
+
+    PrimeClient client;
+    std::vector<PrimeResponse> responses(options.values.size());
+    if (!client.connectTo(options.socketPath) ||
+        !client.lookup(options.values.data(), static_cast<int>(options.values.size()),
+                       responses.data())) {
+        std::cerr << "could not reach the server at " << options.socketPath << "\n";
+        return 1;
+    }
+
+    for (std::size_t i = 0; i < options.values.size(); i++) {
+        std::cout << options.values[i] << ": lower ";
+        if (responses[i].status & PrimeNoLower) {
+            std::cout << "none";
+        } else {
+            std::cout << responses[i].lowerPrime;
+        }
+        std::cout << ", upper ";
+        if (responses[i].status & PrimeNoUpper) {
+            std::cout << "none";
+        } else {
+            std::cout << responses[i].upperPrime;
+        }
+        std::cout << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+// Created by Andrew Asplund
+// Date: 10/19/2026
+// Revision: 1.0
+
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "PrimeServer.h"
+
+/*
+ * The nearest-prime daemon serves lowerPrime/upperPrime lookups to local
+ * clients (see PrimeServer.h and PrimeProtocol.h) until it is interrupted,
+ * then prints its throughput and latency.
+ *
+ * USAGE:
+ *   5011_p4_primed [--socket <path>] [--window-us <n>] [--max-batch <n>]
+ * --window-us is the batch window in microseconds (default 200, 0 to answer
+ * each read at once); --max-batch caps a batch (default 4096).
+ */
+
+namespace {
+
+/// Set by SIGINT and SIGTERM.
+std::atomic<bool> stopRequested{false};
+
+void requestStop(int) {
+    stopRequested.store(true);
+}
+
+/// DaemonOptions holds the command line settings.
+struct DaemonOptions {
+    std::string socketPath = PRIME_DEFAULT_SOCKET_PATH;
+    int windowMicroseconds = PrimeServer::DEFAULT_BATCH_WINDOW;
+    int maxBatch = PrimeServer::DEFAULT_MAX_BATCH;
+};
+
+bool parseOptions(int argc, char *argv[], DaemonOptions &options) {
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if ((option == "--socket") && hasValue) {
+            options.socketPath = argv[++i];
+        } else if ((option == "--window-us") && hasValue) {
+            options.windowMicroseconds = std::atoi(argv[++i]);
+        } else if ((option == "--max-batch") && hasValue) {
+            options.maxBatch = std::atoi(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+
+int main(int argc, char *argv[]) {
+    DaemonOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--socket <path>] [--window-us <n>] [--max-batch <n>]\n";
+        return 2;
+    }
+
+    // no SA_RESTART, so a signal wakes the event loop
+    struct sigaction stopAction = {};
+    stopAction.sa_handler = requestStop;
+    sigaction(SIGINT, &stopAction, nullptr);
+    sigaction(SIGTERM, &stopAction, nullptr);
+
+    PrimeServer server(options.windowMicroseconds, options.maxBatch);
+    if (!server.listenOn(options.socketPath)) {
+        std::cerr << "could not listen on " << options.socketPath << "\n";
+        return 1;
+    }
+    std::cout << "Serving nearest primes on " << options.socketPath << std::endl;
+
+    bool runOk = server.run(stopRequested);
+    server.reportStats(std::cout);
+
+    return runOk ? 0 : 1;
+}